@@ -1,25 +1,45 @@
 TEMPLATE = app
-CONFIG += console c++17
+CONFIG += console c++17 thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
 SOURCES += \
+        agendaalojamientos.cpp \
         alojamiento.cpp \
+        analiticaocupacion.cpp \
         anfitrion.cpp \
+        archivohistorico.cpp \
+        cachebusquedas.cpp \
+        catalogoalojamientos.cpp \
+        diccionarioamenidades.cpp \
+        disponibilidadmunicipios.cpp \
         fecha.cpp \
         gestionarchivos.cpp \
         huesped.cpp \
+        indicehash.cpp \
         main.cpp \
         medicionrecursos.cpp \
         reservacion.cpp \
-        sistema.cpp
+        resumenpagos.cpp \
+        sistema.cpp \
+        solicitudreservacion.cpp
 
 HEADERS += \
+    agendaalojamientos.h \
     alojamiento.h \
+    analiticaocupacion.h \
     anfitrion.h \
+    archivohistorico.h \
+    cachebusquedas.h \
+    catalogoalojamientos.h \
+    diccionarioamenidades.h \
+    disponibilidadmunicipios.h \
     fecha.h \
     gestionarchivos.h \
     huesped.h \
+    indicehash.h \
     medicionrecursos.h \
     reservacion.h \
-    sistema.h
+    resumenpagos.h \
+    sistema.h \
+    solicitudreservacion.h
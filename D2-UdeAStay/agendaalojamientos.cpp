@@ -0,0 +1,556 @@
+#include "agendaalojamientos.h"
+#include "reservacion.h"
+#include "indicehash.h"
+#include "fecha.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Constructor por defecto de la clase AgendaAlojamientos.
+ *
+ * Crea una agenda vacía, sin alojamientos.
+ */
+AgendaAlojamientos::AgendaAlojamientos() : intervalos(nullptr), numIntervalos(nullptr),
+    capacidadIntervalos(nullptr), numAlojamientos(0) {}
+
+/**
+ * @brief Destructor de la clase AgendaAlojamientos.
+ *
+ * Libera los intervalos de todos los alojamientos.
+ */
+AgendaAlojamientos::~AgendaAlojamientos() {
+    liberar();
+}
+
+/**
+ * @brief Libera la memoria de la agenda y la deja vacía.
+ */
+void AgendaAlojamientos::liberar() {
+    for (int a = 0; a < numAlojamientos; ++a) {
+        incrementarIteracion();
+        agregarMemoria(-static_cast<long long>(sizeof(IntervaloOcupado) * capacidadIntervalos[a]));
+        delete[] intervalos[a];
+    }
+    agregarMemoria(-static_cast<long long>((sizeof(IntervaloOcupado*) + sizeof(int) * 2) * numAlojamientos));
+
+    delete[] intervalos;
+    delete[] numIntervalos;
+    delete[] capacidadIntervalos;
+    intervalos = nullptr;
+    numIntervalos = nullptr;
+    capacidadIntervalos = nullptr;
+    numAlojamientos = 0;
+}
+
+/**
+ * @brief Construye la agenda a partir de las reservaciones cargadas.
+ *
+ * Cada reservación se ubica en su alojamiento con una consulta O(1) al índice de
+ * alojamientos por código; las que no corresponden a ningún alojamiento se ignoran.
+ * Luego los intervalos de cada alojamiento se ordenan por día de entrada.
+ *
+ * @param cantidadAlojamientos Cantidad de alojamientos del sistema.
+ * @param reservaciones Arreglo de reservaciones del sistema.
+ * @param numReservaciones Cantidad de reservaciones.
+ * @param indiceAlojamientos Índice código de alojamiento -> posición en el arreglo de alojamientos.
+ */
+void AgendaAlojamientos::construir(int cantidadAlojamientos, const Reservacion* reservaciones,
+                                   int numReservaciones, const IndiceHash& indiceAlojamientos) {
+    liberar();
+    if (cantidadAlojamientos <= 0) return;
+
+    numAlojamientos = cantidadAlojamientos;
+    intervalos = new IntervaloOcupado*[numAlojamientos]();
+    numIntervalos = new int[numAlojamientos]();
+    capacidadIntervalos = new int[numAlojamientos]();
+    agregarMemoria((sizeof(IntervaloOcupado*) + sizeof(int) * 2) * numAlojamientos);
+
+    int* alojamientoDeReservacion = new int[numReservaciones > 0 ? numReservaciones : 1];
+    agregarMemoria(sizeof(int) * numReservaciones);
+
+    // 1. Conteo por alojamiento para reservar la capacidad exacta
+    for (int r = 0; r < numReservaciones; ++r) {
+        incrementarIteracion();
+        int a = indiceAlojamientos.buscar(reservaciones[r].getCodigoAlojamiento());
+        alojamientoDeReservacion[r] = a;
+        if (a >= 0) {
+            capacidadIntervalos[a]++;
+        }
+    }
+    for (int a = 0; a < numAlojamientos; ++a) {
+        incrementarIteracion();
+        if (capacidadIntervalos[a] > 0) {
+            intervalos[a] = new IntervaloOcupado[capacidadIntervalos[a]];
+            agregarMemoria(sizeof(IntervaloOcupado) * capacidadIntervalos[a]);
+        }
+    }
+
+    // 2. Llenado y orden por dia de entrada
+    for (int r = 0; r < numReservaciones; ++r) {
+        incrementarIteracion();
+        int a = alojamientoDeReservacion[r];
+        if (a < 0) continue;
+
+        IntervaloOcupado& intervalo = intervalos[a][numIntervalos[a]++];
+        intervalo.inicio = Fecha(reservaciones[r].getFechaEntrada()).aDiasDesdeFechaBase();
+        intervalo.fin = intervalo.inicio + reservaciones[r].getDuracion();
+        intervalo.reservacion = r;
+    }
+    for (int a = 0; a < numAlojamientos; ++a) {
+        incrementarIteracion();
+        sort(intervalos[a], intervalos[a] + numIntervalos[a],
+             [](const IntervaloOcupado& x, const IntervaloOcupado& y) {
+                 incrementarIteracion();
+                 return x.inicio < y.inicio || (x.inicio == y.inicio && x.reservacion < y.reservacion);
+             });
+        recalcularFinAcumulado(a, 0);
+    }
+
+    delete[] alojamientoDeReservacion;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * numReservaciones));
+}
+
+/**
+ * @brief Recalcula el máximo acumulado de los días de salida desde una posición.
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param desde Primera posición que cambió.
+ */
+void AgendaAlojamientos::recalcularFinAcumulado(int alojamiento, int desde) {
+    IntervaloOcupado* lista = intervalos[alojamiento];
+    for (int k = desde; k < numIntervalos[alojamiento]; ++k) {
+        incrementarIteracion();
+        int anterior = (k > 0) ? lista[k - 1].finAcumulado : lista[k].fin;
+        lista[k].finAcumulado = max(anterior, lista[k].fin);
+    }
+}
+
+/**
+ * @brief Agrega una reservación a la agenda de un alojamiento manteniendo el orden.
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param inicio Día de entrada (días desde la fecha base).
+ * @param noches Cantidad de noches.
+ * @param reservacion Índice de la reservación en el arreglo del sistema.
+ */
+void AgendaAlojamientos::agregar(int alojamiento, int inicio, int noches, int reservacion) {
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) return;
+
+    int& cantidad = numIntervalos[alojamiento];
+    int& capacidad = capacidadIntervalos[alojamiento];
+
+    if (cantidad >= capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? 4 : capacidad * 2;
+        IntervaloOcupado* nuevo = new IntervaloOcupado[nuevaCapacidad];
+        agregarMemoria(sizeof(IntervaloOcupado) * nuevaCapacidad);
+
+        for (int k = 0; k < cantidad; ++k) {
+            incrementarIteracion();
+            nuevo[k] = intervalos[alojamiento][k];
+        }
+
+        agregarMemoria(-static_cast<long long>(sizeof(IntervaloOcupado) * capacidad));
+        delete[] intervalos[alojamiento];
+        intervalos[alojamiento] = nuevo;
+        capacidad = nuevaCapacidad;
+    }
+
+    // Posicion de insercion: despues de los que entran el mismo dia o antes
+    IntervaloOcupado* lista = intervalos[alojamiento];
+    int pos = cantidad;
+    while (pos > 0 && lista[pos - 1].inicio > inicio) {
+        incrementarIteracion();
+        lista[pos] = lista[pos - 1];
+        pos--;
+    }
+
+    lista[pos].inicio = inicio;
+    lista[pos].fin = inicio + noches;
+    lista[pos].reservacion = reservacion;
+    cantidad++;
+    recalcularFinAcumulado(alojamiento, pos);
+}
+
+/**
+ * @brief Quita una reservación de la agenda de un alojamiento.
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param reservacion Índice de la reservación en el arreglo del sistema.
+ * @return true si la reservación estaba en la agenda.
+ */
+bool AgendaAlojamientos::eliminar(int alojamiento, int reservacion) {
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) return false;
+
+    IntervaloOcupado* lista = intervalos[alojamiento];
+    int cantidad = numIntervalos[alojamiento];
+
+    for (int k = 0; k < cantidad; ++k) {
+        incrementarIteracion();
+        if (lista[k].reservacion == reservacion) {
+            for (int j = k; j < cantidad - 1; ++j) {
+                incrementarIteracion();
+                lista[j] = lista[j + 1];
+            }
+            numIntervalos[alojamiento]--;
+            recalcularFinAcumulado(alojamiento, k);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Ajusta los índices de reservación después de eliminar una del arreglo del sistema.
+ *
+ * El sistema elimina reservaciones desplazando las siguientes una posición, así que todos
+ * los índices mayores que el eliminado bajan en uno.
+ *
+ * @note Recorre los intervalos de todos los alojamientos, no solo los del alojamiento o el
+ *       huésped de la cancelación, porque los índices de todos cambian: O(reservaciones
+ *       activas), el mismo orden que el desplazamiento del arreglo y la reescritura de
+ *       "Reservaciones.txt" que hace `eliminarReservacionPorCodigo`.
+ *
+ * @param reservacionEliminada Índice que tenía la reservación eliminada.
+ */
+void AgendaAlojamientos::descontarReservacion(int reservacionEliminada) {
+    for (int a = 0; a < numAlojamientos; ++a) {
+        incrementarIteracion();
+        for (int k = 0; k < numIntervalos[a]; ++k) {
+            int& r = intervalos[a][k].reservacion;
+            r -= (r > reservacionEliminada) ? 1 : 0;
+        }
+    }
+}
+
+/**
+ * @brief Ajusta los índices de reservación después de insertar una en el arreglo del sistema.
+ *
+ * El sistema inserta reservaciones en medio del arreglo para mantenerlo ordenado, así que
+ * todos los índices desde la posición insertada suben en uno.
+ *
+ * @note Recorre los intervalos de todos los alojamientos: O(reservaciones activas) por cada
+ *       reservación nueva, el mismo orden que la copia del arreglo en `agregarReservacion`.
+ *
+ * @param desde Posición donde se insertó la nueva reservación.
+ */
+void AgendaAlojamientos::desplazarReservaciones(int desde) {
+    for (int a = 0; a < numAlojamientos; ++a) {
+        incrementarIteracion();
+        for (int k = 0; k < numIntervalos[a]; ++k) {
+            int& r = intervalos[a][k].reservacion;
+            r += (r >= desde) ? 1 : 0;
+        }
+    }
+}
+
+/**
+ * @brief Quita de la agenda las primeras reservaciones del arreglo del sistema.
+ *
+ * Se usa en el corte histórico, que retira un prefijo del arreglo: los intervalos de esas
+ * reservaciones se eliminan conservando el orden de los demás, cuyos índices bajan en
+ * `cantidad`. No se vuelve a ordenar ni a consultar el índice de alojamientos.
+ *
+ * @note Recorre todos los intervalos, no solo los retirados: el costo es O(reservaciones
+ *       activas), igual que la copia del arreglo que hace el corte.
+ *
+ * @param cantidad Cantidad de reservaciones retiradas del inicio del arreglo.
+ */
+void AgendaAlojamientos::eliminarPrimerasReservaciones(int cantidad) {
+    if (cantidad <= 0) return;
+
+    for (int a = 0; a < numAlojamientos; ++a) {
+        incrementarIteracion();
+        IntervaloOcupado* lista = intervalos[a];
+        int quedan = 0;
+        int primerCambio = -1;
+
+        for (int k = 0; k < numIntervalos[a]; ++k) {
+            incrementarIteracion();
+            if (lista[k].reservacion < cantidad) {
+                if (primerCambio < 0) primerCambio = quedan;
+                continue;
+            }
+            lista[quedan] = lista[k];
+            lista[quedan].reservacion -= cantidad;
+            quedan++;
+        }
+
+        numIntervalos[a] = quedan;
+        if (primerCambio >= 0) {
+            recalcularFinAcumulado(a, primerCambio);
+        }
+    }
+}
+
+/**
+ * @brief Busca el primer intervalo tal que él o alguno anterior termina después de un día.
+ *
+ * Como `finAcumulado` no decrece, los intervalos anteriores a la posición retornada
+ * terminan a más tardar ese día y no pueden ocupar noches desde él en adelante.
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param dia Día desde la fecha base.
+ * @return Posición del primer intervalo con `finAcumulado > dia`.
+ */
+int AgendaAlojamientos::primerIntervaloQueTerminaDespues(int alojamiento, int dia) const {
+    const IntervaloOcupado* lista = intervalos[alojamiento];
+    int bajo = 0;
+    int alto = numIntervalos[alojamiento];
+    while (bajo < alto) {
+        incrementarIteracion();
+        int medio = (bajo + alto) / 2;
+        if (lista[medio].finAcumulado > dia) {
+            alto = medio;
+        } else {
+            bajo = medio + 1;
+        }
+    }
+    return bajo;
+}
+
+/**
+ * @brief Busca la posición del primer intervalo de un alojamiento que entra en un día dado o después.
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param dia Día de referencia (días desde la fecha base).
+ * @return Posición del intervalo, o la cantidad de intervalos si ninguno entra desde ese día.
+ */
+int AgendaAlojamientos::primerIntervaloQueEntraDesde(int alojamiento, int dia) const {
+    const IntervaloOcupado* lista = intervalos[alojamiento];
+    int bajo = 0;
+    int alto = numIntervalos[alojamiento];
+    while (bajo < alto) {
+        incrementarIteracion();
+        int medio = (bajo + alto) / 2;
+        if (lista[medio].inicio >= dia) {
+            alto = medio;
+        } else {
+            bajo = medio + 1;
+        }
+    }
+    return bajo;
+}
+
+/**
+ * @brief Indica si un alojamiento está libre durante una estadía.
+ *
+ * Con una búsqueda binaria se ubica el primer intervalo que entra el día de salida o
+ * después; hay conflicto solo si alguno de los anteriores sale después del día de entrada,
+ * lo que se sabe con el `finAcumulado` del intervalo previo. O(log n).
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param inicio Día de entrada (días desde la fecha base).
+ * @param noches Cantidad de noches.
+ * @return true si ninguna reservación ocupa alguna de esas noches.
+ */
+bool AgendaAlojamientos::estaLibre(int alojamiento, int inicio, int noches) const {
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) return true;
+
+    const IntervaloOcupado* lista = intervalos[alojamiento];
+    const int salida = inicio + noches;
+    int bajo = 0;
+    int alto = numIntervalos[alojamiento];
+    while (bajo < alto) {
+        incrementarIteracion();
+        int medio = (bajo + alto) / 2;
+        if (lista[medio].inicio < salida) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    return bajo == 0 || lista[bajo - 1].finAcumulado <= inicio;
+}
+
+/**
+ * @brief Deja en un arreglo de candidatos solo los alojamientos libres durante una estadía.
+ *
+ * Compacta en el mismo arreglo y conserva el orden de los candidatos.
+ *
+ * @param candidatos [in/out] Índices de alojamientos a evaluar.
+ * @param nCandidatos Cantidad de candidatos.
+ * @param inicio Día de entrada (días desde la fecha base).
+ * @param noches Cantidad de noches.
+ * @return Cantidad de candidatos que quedaron.
+ */
+int AgendaAlojamientos::filtrarLibres(int* candidatos, int nCandidatos, int inicio, int noches) const {
+    int nLibres = 0;
+    for (int i = 0; i < nCandidatos; ++i) {
+        incrementarIteracion();
+        int a = candidatos[i];
+        candidatos[nLibres] = a;
+        nLibres += estaLibre(a, inicio, noches) ? 1 : 0;
+    }
+    return nLibres;
+}
+
+/**
+ * @brief Calcula todas las fechas de entrada posibles de un alojamiento en una ventana.
+ *
+ * Recorre una sola vez los intervalos del alojamiento que pueden afectar la ventana,
+ * avanzando un cursor con el primer día que no está ocupado: entre el cursor y la
+ * siguiente entrada, caben como fechas de inicio los días hasta `entrada - noches`.
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param desde Primer día de entrada aceptable (días desde la fecha base).
+ * @param hasta Último día de entrada aceptable.
+ * @param noches Cantidad de noches.
+ * @param rangos [out] Pares [primer día, último día] de entradas posibles. Debe tener
+ *               capacidad para 2 * (getNumIntervalos(alojamiento) + 1) enteros; puede ser
+ *               nullptr si solo interesa saber si hay alguna fecha posible.
+ * @return Cantidad de rangos (0 si no hay ninguna fecha de entrada posible).
+ */
+int AgendaAlojamientos::calcularIniciosPosibles(int alojamiento, int desde, int hasta, int noches,
+                                                int* rangos) const {
+    if (desde > hasta) return 0;
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) {
+        if (rangos) {
+            rangos[0] = desde;
+            rangos[1] = hasta;
+        }
+        return 1;
+    }
+
+    const IntervaloOcupado* lista = intervalos[alojamiento];
+    const int cantidad = numIntervalos[alojamiento];
+    int numRangos = 0;
+    int cursor = desde;
+
+    for (int k = primerIntervaloQueTerminaDespues(alojamiento, desde); k < cantidad && cursor <= hasta; ++k) {
+        incrementarIteracion();
+        int ultimoInicio = min(lista[k].inicio - noches, hasta);
+        if (ultimoInicio >= cursor) {
+            if (!rangos) return 1;
+            rangos[2 * numRangos] = cursor;
+            rangos[2 * numRangos + 1] = ultimoInicio;
+            numRangos++;
+        }
+        if (lista[k].inicio - noches >= hasta) {
+            // Los intervalos restantes entran despues de cualquier estadia de la ventana
+            cursor = hasta + 1;
+            break;
+        }
+        cursor = max(cursor, lista[k].fin);
+    }
+
+    if (cursor <= hasta) {
+        if (!rangos) return 1;
+        rangos[2 * numRangos] = cursor;
+        rangos[2 * numRangos + 1] = hasta;
+        numRangos++;
+    }
+    return numRangos;
+}
+
+/**
+ * @brief Deja en un arreglo de candidatos solo los alojamientos con alguna fecha de entrada posible.
+ *
+ * Compacta en el mismo arreglo y conserva el orden de los candidatos. Para cada uno el
+ * recorrido se detiene en el primer hueco suficiente.
+ *
+ * @param candidatos [in/out] Índices de alojamientos a evaluar.
+ * @param nCandidatos Cantidad de candidatos.
+ * @param desde Primer día de entrada aceptable (días desde la fecha base).
+ * @param hasta Último día de entrada aceptable.
+ * @param noches Cantidad de noches.
+ * @return Cantidad de candidatos que quedaron.
+ */
+int AgendaAlojamientos::filtrarConInicioPosible(int* candidatos, int nCandidatos, int desde, int hasta,
+                                                int noches) const {
+    int nPosibles = 0;
+    for (int i = 0; i < nCandidatos; ++i) {
+        incrementarIteracion();
+        int a = candidatos[i];
+        candidatos[nPosibles] = a;
+        nPosibles += (calcularIniciosPosibles(a, desde, hasta, noches, nullptr) > 0) ? 1 : 0;
+    }
+    return nPosibles;
+}
+
+/**
+ * @brief Ubica los intervalos de un alojamiento cuyo día de entrada está dentro de un rango.
+ *
+ * Como los intervalos están ordenados por día de entrada, los que cumplen forman un tramo
+ * contiguo que se encuentra con dos búsquedas binarias. O(log n).
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param desde Primer día de entrada del rango (días desde la fecha base).
+ * @param hasta Último día de entrada del rango (inclusive).
+ * @param primero [out] Posición del primer intervalo del tramo en `getIntervalos(alojamiento)`.
+ * @return Cantidad de intervalos del tramo.
+ */
+int AgendaAlojamientos::buscarEntradasEnRango(int alojamiento, int desde, int hasta, int& primero) const {
+    primero = 0;
+    if (alojamiento < 0 || alojamiento >= numAlojamientos || hasta < desde) return 0;
+
+    primero = primerIntervaloQueEntraDesde(alojamiento, desde);
+    return primerIntervaloQueEntraDesde(alojamiento, hasta + 1) - primero;
+}
+
+/**
+ * @brief Mapa de bits con las noches ocupadas de un alojamiento en una ventana corta.
+ *
+ * Solo se recorren los intervalos que tocan la ventana: el primero se ubica con una búsqueda
+ * binaria sobre `finAcumulado` y el recorrido termina en el primero que entra después de la
+ * ventana. Cada intervalo marca su tramo con una sola máscara. O(log n + intervalos de la ventana).
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param desde Primera noche de la ventana (días desde la fecha base).
+ * @param dias Noches de la ventana (entre 1 y 32, p. ej. un mes).
+ * @return Mapa de bits: el bit d está encendido si la noche `desde + d` está ocupada.
+ *
+ * @throws std::invalid_argument si la ventana no tiene entre 1 y 32 noches.
+ */
+unsigned int AgendaAlojamientos::calcularMapaOcupacion(int alojamiento, int desde, int dias) const {
+    if (dias <= 0 || dias > 32) {
+        throw invalid_argument("La ventana del mapa de ocupacion debe tener entre 1 y 32 noches.");
+    }
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) return 0;
+
+    const IntervaloOcupado* lista = intervalos[alojamiento];
+    const int cantidad = numIntervalos[alojamiento];
+    const int hasta = desde + dias;
+    unsigned int mapa = 0;
+
+    for (int k = primerIntervaloQueTerminaDespues(alojamiento, desde); k < cantidad && lista[k].inicio < hasta; ++k) {
+        incrementarIteracion();
+        int inicio = max(lista[k].inicio, desde) - desde;
+        int fin = min(lista[k].fin, hasta) - desde;
+        if (inicio < fin) {
+            unsigned int tramo = (fin - inicio == 32) ? ~0u : ((1u << (fin - inicio)) - 1);
+            mapa |= tramo << inicio;
+        }
+    }
+    return mapa;
+}
+
+/**
+ * @brief Primer día de entrada, desde un día dado, con `noches` noches libres seguidas.
+ *
+ * Se ubica con una búsqueda binaria el primer intervalo que puede ocupar noches desde `desde`
+ * y se recorren los huecos entre reservaciones con un cursor en el primer día no ocupado,
+ * deteniéndose en el primer hueco donde cabe la estadía. O(log n + huecos recorridos).
+ *
+ * @param alojamiento Índice del alojamiento.
+ * @param desde Primer día de entrada aceptable (días desde la fecha base).
+ * @param noches Cantidad de noches.
+ * @return Primer día de entrada posible; siempre existe, a más tardar al salir la última reservación.
+ */
+int AgendaAlojamientos::buscarProximaEntradaLibre(int alojamiento, int desde, int noches) const {
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) return desde;
+
+    const IntervaloOcupado* lista = intervalos[alojamiento];
+    const int cantidad = numIntervalos[alojamiento];
+    int cursor = desde;
+
+    for (int k = primerIntervaloQueTerminaDespues(alojamiento, desde); k < cantidad; ++k) {
+        incrementarIteracion();
+        if (lista[k].inicio - cursor >= noches) break;
+        cursor = max(cursor, lista[k].fin);
+    }
+    return cursor;
+}
@@ -0,0 +1,64 @@
+#ifndef AGENDAALOJAMIENTOS_H
+#define AGENDAALOJAMIENTOS_H
+
+class Reservacion;
+class IndiceHash;
+
+// Noches ocupadas por una reservacion: dias [inicio, fin) contados desde la fecha base
+struct IntervaloOcupado {
+    int inicio;
+    int fin;
+    int finAcumulado;   // Mayor 'fin' de este intervalo y todos los anteriores del alojamiento
+    int reservacion;    // Indice en el arreglo de reservaciones del sistema
+};
+
+// Agenda de ocupacion: por cada alojamiento, sus reservaciones ordenadas por dia de entrada
+class AgendaAlojamientos {
+private:
+
+    IntervaloOcupado** intervalos;
+    int* numIntervalos;
+    int* capacidadIntervalos;
+    int numAlojamientos;
+
+    void liberar();
+    void recalcularFinAcumulado(int alojamiento, int desde);
+    int primerIntervaloQueTerminaDespues(int alojamiento, int dia) const;
+    int primerIntervaloQueEntraDesde(int alojamiento, int dia) const;
+
+public:
+
+    // Constructor
+    AgendaAlojamientos();
+
+    // Destructor
+    ~AgendaAlojamientos();
+
+    // No copiable: es duena de sus arreglos
+    AgendaAlojamientos(const AgendaAlojamientos&) = delete;
+    AgendaAlojamientos& operator=(const AgendaAlojamientos&) = delete;
+
+    // Getters
+    int getNumIntervalos(int alojamiento) const { return numIntervalos[alojamiento]; }
+    const IntervaloOcupado* getIntervalos(int alojamiento) const { return intervalos[alojamiento]; }
+
+    // Metodos de mantenimiento
+    void construir(int cantidadAlojamientos, const Reservacion* reservaciones, int numReservaciones,
+                   const IndiceHash& indiceAlojamientos);
+    void agregar(int alojamiento, int inicio, int noches, int reservacion);
+    bool eliminar(int alojamiento, int reservacion);
+    void descontarReservacion(int reservacionEliminada);
+    void desplazarReservaciones(int desde);
+    void eliminarPrimerasReservaciones(int cantidad);
+
+    // Consultas
+    bool estaLibre(int alojamiento, int inicio, int noches) const;
+    int filtrarLibres(int* candidatos, int nCandidatos, int inicio, int noches) const;
+    int calcularIniciosPosibles(int alojamiento, int desde, int hasta, int noches, int* rangos) const;
+    int filtrarConInicioPosible(int* candidatos, int nCandidatos, int desde, int hasta, int noches) const;
+    int buscarEntradasEnRango(int alojamiento, int desde, int hasta, int& primero) const;
+    unsigned int calcularMapaOcupacion(int alojamiento, int desde, int dias) const;
+    int buscarProximaEntradaLibre(int alojamiento, int desde, int noches) const;
+};
+
+#endif // AGENDAALOJAMIENTOS_H
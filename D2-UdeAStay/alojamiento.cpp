@@ -1,9 +1,9 @@
 #include "alojamiento.h"
 #include "reservacion.h"
 #include "anfitrion.h"
+#include "diccionarioamenidades.h"
 #include "medicionrecursos.h"
 
-#include <sstream>
 #include <stdexcept>
 
 using namespace std;
@@ -11,12 +11,11 @@ using namespace std;
 /**
  * @brief Constructor por defecto de la clase Alojamiento.
  *
- * Inicializa los atributos con valores predeterminados.
- * Crea un arreglo de amenidades vacío (puntero a nullptr).
+ * Inicializa los atributos con valores predeterminados y sin amenidades.
  */
 Alojamiento::Alojamiento() : codigo(""), nombre(""), documento(""), departamento(""),
     municipio(""), tipo('C'), direccion(""), precio(0.0f),
-    amenidades(nullptr), capacidad(0), numAmenidades(0){}
+    mascaraAmenidades(0), amenidadesExtra(nullptr), numAmenidadesExtra(0), numAmenidades(0){}
 
 /**
  * @brief Constructor principal de la clase Alojamiento.
@@ -38,7 +37,7 @@ Alojamiento::Alojamiento(const string& cod, const string& nom, const string& doc
                          const string& dir, float prec, const string& ameStr) :
     codigo(cod), nombre(nom), documento(docAnf), departamento(dep),
     municipio(mun), tipo(tip), direccion(dir), precio(prec),
-    capacidad(10), numAmenidades(0) {
+    mascaraAmenidades(0), amenidadesExtra(nullptr), numAmenidadesExtra(0), numAmenidades(0) {
 
     if (tipo != 'C' && tipo != 'A') {
         throw invalid_argument("Tipo de alojamiento invalido");
@@ -47,9 +46,6 @@ Alojamiento::Alojamiento(const string& cod, const string& nom, const string& doc
         throw invalid_argument("El precio no puede ser negativo");
     }
 
-    amenidades = new string[capacidad];
-    agregarMemoria(sizeof(string) * capacidad);
-
     procesarAmenidades(ameStr);
 }
 
@@ -64,14 +60,17 @@ Alojamiento::Alojamiento(const Alojamiento& otro) :
     codigo(otro.codigo), nombre(otro.nombre), documento(otro.documento),
     departamento(otro.departamento), municipio(otro.municipio),
     tipo(otro.tipo), direccion(otro.direccion), precio(otro.precio),
-    capacidad(otro.capacidad), numAmenidades(otro.numAmenidades) {
+    mascaraAmenidades(otro.mascaraAmenidades), amenidadesExtra(nullptr),
+    numAmenidadesExtra(otro.numAmenidadesExtra), numAmenidades(otro.numAmenidades) {
 
-    amenidades = new string[capacidad];
-    agregarMemoria(sizeof(string) * capacidad);
+    if (numAmenidadesExtra > 0) {
+        amenidadesExtra = new int[numAmenidadesExtra];
+        agregarMemoria(sizeof(int) * numAmenidadesExtra);
 
-    for (int i = 0; i < numAmenidades; i++) {
-        amenidades[i] = otro.amenidades[i];
-        incrementarIteracion();
+        for (int i = 0; i < numAmenidadesExtra; i++) {
+            amenidadesExtra[i] = otro.amenidadesExtra[i];
+            incrementarIteracion();
+        }
     }
 }
 
@@ -86,8 +85,9 @@ Alojamiento::Alojamiento(const Alojamiento& otro) :
 Alojamiento& Alojamiento::operator=(const Alojamiento& otro) {
     if (this != &otro) {
 
-        agregarMemoria(-sizeof(string) * capacidad);
-        delete[] amenidades;
+        agregarMemoria(-static_cast<long long>(sizeof(int) * numAmenidadesExtra));
+        delete[] amenidadesExtra;
+        amenidadesExtra = nullptr;
 
         codigo = otro.codigo;
         nombre = otro.nombre;
@@ -97,15 +97,18 @@ Alojamiento& Alojamiento::operator=(const Alojamiento& otro) {
         tipo = otro.tipo;
         direccion = otro.direccion;
         precio = otro.precio;
-        capacidad = otro.capacidad;
+        mascaraAmenidades = otro.mascaraAmenidades;
+        numAmenidadesExtra = otro.numAmenidadesExtra;
         numAmenidades = otro.numAmenidades;
 
-        amenidades = new string[capacidad];
-        agregarMemoria(sizeof(string) * capacidad);
+        if (numAmenidadesExtra > 0) {
+            amenidadesExtra = new int[numAmenidadesExtra];
+            agregarMemoria(sizeof(int) * numAmenidadesExtra);
 
-        for (int i = 0; i < numAmenidades; i++) {
-            amenidades[i] = otro.amenidades[i];
-            incrementarIteracion();
+            for (int i = 0; i < numAmenidadesExtra; i++) {
+                amenidadesExtra[i] = otro.amenidadesExtra[i];
+                incrementarIteracion();
+            }
         }
 
     }
@@ -115,52 +118,109 @@ Alojamiento& Alojamiento::operator=(const Alojamiento& otro) {
 /**
  * @brief Destructor de la clase Alojamiento.
  *
- * Libera la memoria dinámica asociada al arreglo de amenidades.
+ * Libera la memoria dinámica de las amenidades que no caben en la máscara.
  */
 Alojamiento::~Alojamiento() {
     //inicializarContador();
-    agregarMemoria(-sizeof(string) * capacidad);
-    delete[] amenidades;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * numAmenidadesExtra));
+    delete[] amenidadesExtra;
 }
 
 /**
  * @brief Agrega una nueva amenidad al alojamiento.
  *
- * Si se alcanza la capacidad del arreglo, se duplica su tamaño antes de agregar.
- * También actualiza el conteo de iteraciones y memoria usada.
+ * El texto se registra en el diccionario global de amenidades y el alojamiento
+ * solo guarda su id. Las amenidades repetidas se ignoran.
  *
  * @param amenidad Nombre de la amenidad a agregar.
  */
 void Alojamiento::agregarAmenidad(const string& amenidad) {
     incrementarIteracion();
-    if (numAmenidades >= capacidad) {
-        // Medimos memoria antes y después de redimensionar
-        agregarMemoria(-sizeof(string) * capacidad);
-
-        // Redimensionar
-        capacidad *= 2;
-        string* nuevo = new string[capacidad];
-        agregarMemoria(sizeof(string) * capacidad);
-
-        // Copiar existentes
-        for (int i = 0; i < numAmenidades; i++) {
-            nuevo[i] = amenidades[i];
+    int id = DiccionarioAmenidades::internar(amenidad);
+    if (id >= 0) {
+        agregarAmenidadId(id);
+    }
+}
+
+/**
+ * @brief Marca una amenidad (por id) como disponible en el alojamiento.
+ *
+ * Si el id cabe en la máscara se enciende su bit; si no, se agrega al arreglo de ids extra.
+ *
+ * @param id Id de la amenidad en el diccionario global.
+ */
+void Alojamiento::agregarAmenidadId(int id) {
+    if (tieneAmenidad(id)) return;
+
+    if (id < DiccionarioAmenidades::BITS_MASCARA) {
+        mascaraAmenidades |= DiccionarioAmenidades::bitDe(id);
+    } else {
+        int* nuevo = new int[numAmenidadesExtra + 1];
+        agregarMemoria(sizeof(int) * (numAmenidadesExtra + 1));
+
+        for (int i = 0; i < numAmenidadesExtra; i++) {
+            nuevo[i] = amenidadesExtra[i];
             incrementarIteracion();
         }
+        nuevo[numAmenidadesExtra] = id;
 
-        delete[] amenidades;
-        amenidades = nuevo;
+        agregarMemoria(-static_cast<long long>(sizeof(int) * numAmenidadesExtra));
+        delete[] amenidadesExtra;
+        amenidadesExtra = nuevo;
+        numAmenidadesExtra++;
     }
+    numAmenidades++;
+}
 
-    // Agregar nueva amenidad
-    amenidades[numAmenidades++] = amenidad;
+/**
+ * @brief Indica si el alojamiento tiene una amenidad.
+ *
+ * @param id Id de la amenidad en el diccionario global.
+ * @return true si el alojamiento la tiene.
+ */
+bool Alojamiento::tieneAmenidad(int id) const {
+    if (id < 0) return false;
+    if (id < DiccionarioAmenidades::BITS_MASCARA) {
+        return (mascaraAmenidades & DiccionarioAmenidades::bitDe(id)) != 0;
+    }
+    for (int i = 0; i < numAmenidadesExtra; i++) {
+        incrementarIteracion();
+        if (amenidadesExtra[i] == id) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Escribe los ids de las amenidades del alojamiento.
+ *
+ * Primero van los ids de la máscara, en orden ascendente, y luego los extra.
+ *
+ * @param ids [out] Arreglo con capacidad para `getNumAmenidades()` ids.
+ * @return Cantidad de ids escritos.
+ */
+int Alojamiento::obtenerIdsAmenidades(int* ids) const {
+    int cantidad = 0;
+    unsigned long long restantes = mascaraAmenidades;
+    for (int id = 0; restantes != 0; ++id, restantes >>= 1) {
+        incrementarIteracion();
+        if (restantes & 1ULL) {
+            ids[cantidad++] = id;
+        }
+    }
+    for (int i = 0; i < numAmenidadesExtra; ++i) {
+        incrementarIteracion();
+        ids[cantidad++] = amenidadesExtra[i];
+    }
+    return cantidad;
 }
 
 /**
  * @brief Obtiene una amenidad específica del alojamiento.
  *
+ * Las amenidades se enumeran por id: primero las de la máscara y luego las extra.
+ *
  * @param index Índice de la amenidad a obtener.
- * @return Referencia constante a la cadena de la amenidad.
+ * @return Referencia constante al texto de la amenidad en el diccionario.
  *
  * @throws std::out_of_range si el índice es inválido.
  */
@@ -169,32 +229,38 @@ const string& Alojamiento::obtenerAmenidad(int index) const {
         throw out_of_range("Indice de amenidad invalido");
     }
     incrementarIteracion();
-    return amenidades[index];
+
+    unsigned long long restantes = mascaraAmenidades;
+    for (int id = 0; restantes != 0; ++id, restantes >>= 1) {
+        incrementarIteracion();
+        if ((restantes & 1ULL) && index-- == 0) {
+            return DiccionarioAmenidades::getNombre(id);
+        }
+    }
+    return DiccionarioAmenidades::getNombre(amenidadesExtra[index]);
 }
 
 /**
  * @brief Procesa una cadena de texto con amenidades separadas por comas.
  *
- * Divide la cadena, limpia espacios, convierte a minúsculas y agrega cada amenidad.
+ * Divide la cadena en las comas y agrega cada amenidad no vacía; la limpieza de
+ * espacios y mayúsculas la hace el diccionario al registrarla.
  *
  * @param amenidadesStr Cadena de amenidades separadas por comas.
  */
 void Alojamiento::procesarAmenidades(const string& amenidadesStr) {
-    stringstream ss(amenidadesStr);
-    string amenidad;
+    size_t inicio = 0;
 
-    while (getline(ss, amenidad, ',')) {
+    while (inicio < amenidadesStr.size()) {
         incrementarIteracion();
-        // Eliminar espacios al inicio y final
-        amenidad.erase(0, amenidad.find_first_not_of(' '));
-        amenidad.erase(amenidad.find_last_not_of(' ') + 1);
-
-        // Convertir a minusculas para estandarizar
-        transform(amenidad.begin(), amenidad.end(), amenidad.begin(), ::tolower);
+        size_t coma = amenidadesStr.find(',', inicio);
+        if (coma == string::npos) coma = amenidadesStr.size();
 
-        if (!amenidad.empty()) {
-            agregarAmenidad(amenidad);
+        int id = DiccionarioAmenidades::internar(amenidadesStr.substr(inicio, coma - inicio));
+        if (id >= 0) {
+            agregarAmenidadId(id);
         }
+        inicio = coma + 1;
     }
 }
 
@@ -249,10 +315,17 @@ void Alojamiento::mostrar() const {
     if (numAmenidades == 0) {
         cout << "Ninguna";
     } else {
-        for (int i = 0; i < numAmenidades; ++i) {
+        int mostradas = 0;
+        unsigned long long restantes = mascaraAmenidades;
+        for (int id = 0; restantes != 0; ++id, restantes >>= 1) {
+            incrementarIteracion();
+            if (restantes & 1ULL) {
+                cout << (mostradas++ > 0 ? ", " : "") << DiccionarioAmenidades::getNombre(id);
+            }
+        }
+        for (int i = 0; i < numAmenidadesExtra; ++i) {
             incrementarIteracion();
-            cout << amenidades[i];
-            if (i < numAmenidades - 1) cout << ", ";
+            cout << (mostradas++ > 0 ? ", " : "") << DiccionarioAmenidades::getNombre(amenidadesExtra[i]);
         }
     }
     cout << endl;
@@ -19,10 +19,15 @@ private:
     string direccion;
     float precio;
 
-    string* amenidades;
-    int capacidad;
+    // Amenidades como ids del diccionario global: bit i de la mascara = amenidad con id i.
+    // Los ids que no caben en la mascara se guardan aparte (normalmente no hay ninguno).
+    unsigned long long mascaraAmenidades;
+    int* amenidadesExtra;
+    int numAmenidadesExtra;
     int numAmenidades;
 
+    void agregarAmenidadId(int id);
+
     //Anfitrion* anfitrion;
 
 public:
@@ -36,7 +41,10 @@ public:
     // Métodos para amenidades
     void agregarAmenidad(const string& amenidad);
     const string& obtenerAmenidad(int index) const;
+    bool tieneAmenidad(int id) const;
+    int obtenerIdsAmenidades(int* ids) const;
     int getNumAmenidades() const { return numAmenidades; }
+    unsigned long long getMascaraAmenidades() const { return mascaraAmenidades; }
     void procesarAmenidades(const string& amenidadesStr);
 
     // Getters
@@ -44,8 +52,9 @@ public:
     const string& getNombre() const { return nombre; }
     char getTipo() const { return tipo; }
     float getPrecio() const { return precio; }
-    const string getMunicipio() const { return municipio; }
-    const string getDocumentoAnfitrion() const { return documento; }
+    const string& getDepartamento() const { return departamento; }
+    const string& getMunicipio() const { return municipio; }
+    const string& getDocumentoAnfitrion() const { return documento; }
 
     // Métodos principales
     bool estaDisponible(const Alojamiento& a, const Fecha& entrada, int noches,
@@ -0,0 +1,217 @@
+#include "analiticaocupacion.h"
+#include "fecha.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+// Filas minimas que justifican un hilo adicional en el calculo
+const int MIN_FILAS_POR_HILO = 4096;
+
+// Filas que se reservan al agregar la primera reservacion
+const int CAPACIDAD_INICIAL_FILAS = 64;
+
+/**
+ * @brief Constructor de la clase AnaliticaOcupacion.
+ *
+ * @param numAlojamientos Cantidad de alojamientos del reporte (posiciones 0 .. numAlojamientos - 1).
+ * @param anio Año del reporte.
+ *
+ * @throws std::invalid_argument si la cantidad de alojamientos es negativa o el año no es válido.
+ */
+AnaliticaOcupacion::AnaliticaOcupacion(int numAlojamientos, int anio) : anio(anio),
+    numAlojamientos(numAlojamientos), columnaAlojamiento(nullptr), columnaEntrada(nullptr),
+    columnaNoches(nullptr), columnaMonto(nullptr), numFilas(0), capacidadFilas(0),
+    nochesVendidas(nullptr), ingresos(nullptr) {
+
+    if (numAlojamientos < 0) {
+        throw invalid_argument("La cantidad de alojamientos no puede ser negativa.");
+    }
+    if (!Fecha(1, 1, anio).esValida()) {
+        throw invalid_argument("Anio fuera del rango valido.");
+    }
+
+    for (int mes = 0; mes < 12; ++mes) {
+        incrementarIteracion();
+        inicioMes[mes] = Fecha(1, mes + 1, anio).aDiasDesdeFechaBase();
+    }
+    inicioMes[12] = Fecha(1, 1, anio + 1).aDiasDesdeFechaBase();
+
+    int celdas = max(numAlojamientos * 12, 1);
+    nochesVendidas = new long long[celdas]();
+    ingresos = new long long[celdas]();
+    agregarMemoria(sizeof(long long) * 2 * celdas);
+}
+
+/**
+ * @brief Destructor de la clase AnaliticaOcupacion.
+ */
+AnaliticaOcupacion::~AnaliticaOcupacion() {
+    int celdas = max(numAlojamientos * 12, 1);
+    delete[] nochesVendidas;
+    delete[] ingresos;
+    agregarMemoria(-static_cast<long long>(sizeof(long long) * 2 * celdas));
+
+    delete[] columnaAlojamiento;
+    delete[] columnaEntrada;
+    delete[] columnaNoches;
+    delete[] columnaMonto;
+    agregarMemoria(-static_cast<long long>((sizeof(int) * 3 + sizeof(long long)) * capacidadFilas));
+}
+
+/**
+ * @brief Agrega una reservación a las columnas del cálculo.
+ *
+ * Las reservaciones cuyas noches no tocan el año se descartan de inmediato.
+ *
+ * @param alojamiento Posición del alojamiento en el reporte.
+ * @param diaEntrada Día de entrada, contado desde la fecha base.
+ * @param noches Duración de la estadía.
+ * @param monto Monto pagado por la estadía completa.
+ *
+ * @throws std::out_of_range si la posición del alojamiento no pertenece al reporte.
+ */
+void AnaliticaOcupacion::agregarReservacion(int alojamiento, int diaEntrada, int noches, long long monto) {
+    if (alojamiento < 0 || alojamiento >= numAlojamientos) {
+        throw out_of_range("Alojamiento fuera del reporte.");
+    }
+    if (noches <= 0 || diaEntrada >= inicioMes[12] || diaEntrada + noches <= inicioMes[0]) {
+        return;
+    }
+
+    if (numFilas == capacidadFilas) {
+        int nuevaCapacidad = (capacidadFilas == 0) ? CAPACIDAD_INICIAL_FILAS : capacidadFilas * 2;
+        int* nuevoAlojamiento = new int[nuevaCapacidad];
+        int* nuevaEntrada = new int[nuevaCapacidad];
+        int* nuevasNoches = new int[nuevaCapacidad];
+        long long* nuevoMonto = new long long[nuevaCapacidad];
+        agregarMemoria((sizeof(int) * 3 + sizeof(long long)) * nuevaCapacidad);
+
+        copy(columnaAlojamiento, columnaAlojamiento + numFilas, nuevoAlojamiento);
+        copy(columnaEntrada, columnaEntrada + numFilas, nuevaEntrada);
+        copy(columnaNoches, columnaNoches + numFilas, nuevasNoches);
+        copy(columnaMonto, columnaMonto + numFilas, nuevoMonto);
+
+        delete[] columnaAlojamiento;
+        delete[] columnaEntrada;
+        delete[] columnaNoches;
+        delete[] columnaMonto;
+        agregarMemoria(-static_cast<long long>((sizeof(int) * 3 + sizeof(long long)) * capacidadFilas));
+
+        columnaAlojamiento = nuevoAlojamiento;
+        columnaEntrada = nuevaEntrada;
+        columnaNoches = nuevasNoches;
+        columnaMonto = nuevoMonto;
+        capacidadFilas = nuevaCapacidad;
+    }
+
+    incrementarIteracion();
+    columnaAlojamiento[numFilas] = alojamiento;
+    columnaEntrada[numFilas] = diaEntrada;
+    columnaNoches[numFilas] = noches;
+    columnaMonto[numFilas] = monto;
+    numFilas++;
+}
+
+/**
+ * @brief Acumula un tramo de filas en unos totales por alojamiento y mes.
+ *
+ * Cada estadía reparte sus noches entre los meses que toca y el monto en proporción a
+ * ellas; el reparto se hace con las noches acumuladas desde la entrada, así la suma de las
+ * partes es exactamente el monto aunque la estadía cruce varios meses.
+ *
+ * @param desde Primera fila del tramo.
+ * @param hasta Fila siguiente a la última del tramo.
+ * @param noches [in/out] Noches vendidas por alojamiento y mes.
+ * @param montos [in/out] Ingresos por alojamiento y mes.
+ *
+ * @note Se ejecuta en hilos secundarios: no actualiza los contadores de medición.
+ */
+void AnaliticaOcupacion::acumular(int desde, int hasta, long long* noches, long long* montos) const {
+    for (int i = desde; i < hasta; ++i) {
+        int entrada = columnaEntrada[i];
+        int duracion = columnaNoches[i];
+        int primerDia = max(entrada, inicioMes[0]);
+        int ultimoDia = min(entrada + duracion, inicioMes[12]);
+        long long* nochesAlojamiento = noches + columnaAlojamiento[i] * 12;
+        long long* montosAlojamiento = montos + columnaAlojamiento[i] * 12;
+
+        int mes = static_cast<int>(upper_bound(inicioMes, inicioMes + 13, primerDia) - inicioMes) - 1;
+        for (; mes < 12 && inicioMes[mes] < ultimoDia; ++mes) {
+            int inicioTramo = max(primerDia, inicioMes[mes]);
+            int finTramo = min(ultimoDia, inicioMes[mes + 1]);
+            nochesAlojamiento[mes] += finTramo - inicioTramo;
+            montosAlojamiento[mes] += columnaMonto[i] * (finTramo - entrada) / duracion
+                                    - columnaMonto[i] * (inicioTramo - entrada) / duracion;
+        }
+    }
+}
+
+/**
+ * @brief Calcula las noches vendidas y los ingresos por alojamiento y mes.
+ *
+ * Las filas se reparten en tramos contiguos, uno por hilo; cada hilo acumula en sus propios
+ * totales (sin sincronización) y al terminar se suman en los resultados.
+ *
+ * @param numHilos Hilos a usar; 0 para decidir según los núcleos disponibles y la cantidad
+ *                 de filas (al menos `MIN_FILAS_POR_HILO` por hilo).
+ */
+void AnaliticaOcupacion::calcular(int numHilos) {
+    int celdas = numAlojamientos * 12;
+    fill(nochesVendidas, nochesVendidas + celdas, 0);
+    fill(ingresos, ingresos + celdas, 0);
+
+    if (numHilos <= 0) {
+        numHilos = max(1, static_cast<int>(thread::hardware_concurrency()));
+    }
+    numHilos = max(1, min(numHilos, numFilas / MIN_FILAS_POR_HILO));
+
+    if (numHilos == 1) {
+        acumular(0, numFilas, nochesVendidas, ingresos);
+    } else {
+        // Totales parciales de cada hilo, en un solo arreglo
+        long long* parciales = new long long[static_cast<size_t>(celdas) * 2 * numHilos]();
+        agregarMemoria(sizeof(long long) * celdas * 2 * numHilos);
+        thread* hilos = new thread[numHilos];
+
+        int filasPorHilo = (numFilas + numHilos - 1) / numHilos;
+        for (int h = 0; h < numHilos; ++h) {
+            int desde = min(h * filasPorHilo, numFilas);
+            int hasta = min(desde + filasPorHilo, numFilas);
+            long long* nochesHilo = parciales + static_cast<size_t>(celdas) * 2 * h;
+            hilos[h] = thread(&AnaliticaOcupacion::acumular, this, desde, hasta, nochesHilo, nochesHilo + celdas);
+        }
+        for (int h = 0; h < numHilos; ++h) {
+            hilos[h].join();
+        }
+
+        for (int h = 0; h < numHilos; ++h) {
+            const long long* nochesHilo = parciales + static_cast<size_t>(celdas) * 2 * h;
+            for (int c = 0; c < celdas; ++c) {
+                nochesVendidas[c] += nochesHilo[c];
+                ingresos[c] += nochesHilo[celdas + c];
+            }
+        }
+
+        delete[] hilos;
+        delete[] parciales;
+        agregarMemoria(-static_cast<long long>(sizeof(long long) * celdas * 2 * numHilos));
+    }
+
+    // Los hilos no tocan los contadores globales: el recorrido se registra una vez, aqui
+    agregarIteraciones(numFilas);
+}
+
+/**
+ * @brief Tasa de ocupación de un alojamiento en un mes.
+ *
+ * @param alojamiento Posición del alojamiento en el reporte.
+ * @param mes Mes (0 = enero).
+ * @return Noches vendidas sobre días del mes, entre 0 y 1.
+ */
+float AnaliticaOcupacion::getOcupacion(int alojamiento, int mes) const {
+    return static_cast<float>(getNochesVendidas(alojamiento, mes)) / getDiasDelMes(mes);
+}
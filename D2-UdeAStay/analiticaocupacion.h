@@ -0,0 +1,57 @@
+#ifndef ANALITICAOCUPACION_H
+#define ANALITICAOCUPACION_H
+
+using namespace std;
+
+// Ocupacion e ingresos por alojamiento y mes de un anio.
+// Las reservaciones se guardan como columnas de enteros (alojamiento, dia de entrada, noches
+// y monto) y se reducen en paralelo: cada hilo acumula un tramo de filas en sus propios
+// totales y al final se suman.
+class AnaliticaOcupacion {
+private:
+
+    int anio;
+    int numAlojamientos;
+    int inicioMes[13];          // Primer dia de cada mes (y del anio siguiente) desde la fecha base
+
+    // Columnas de las reservaciones que tocan el anio
+    int* columnaAlojamiento;    // Posicion del alojamiento en el reporte
+    int* columnaEntrada;        // Dia de entrada desde la fecha base
+    int* columnaNoches;
+    long long* columnaMonto;
+    int numFilas;
+    int capacidadFilas;
+
+    // Resultados: [alojamiento * 12 + mes]
+    long long* nochesVendidas;
+    long long* ingresos;
+
+    void acumular(int desde, int hasta, long long* noches, long long* montos) const;
+
+public:
+
+    // Constructor
+    AnaliticaOcupacion(int numAlojamientos, int anio);
+
+    // Destructor
+    ~AnaliticaOcupacion();
+
+    // No copiable: es duena de sus arreglos
+    AnaliticaOcupacion(const AnaliticaOcupacion&) = delete;
+    AnaliticaOcupacion& operator=(const AnaliticaOcupacion&) = delete;
+
+    // Getters
+    int getAnio() const { return anio; }
+    int getNumAlojamientos() const { return numAlojamientos; }
+    int getNumFilas() const { return numFilas; }
+    int getDiasDelMes(int mes) const { return inicioMes[mes + 1] - inicioMes[mes]; }
+    long long getNochesVendidas(int alojamiento, int mes) const { return nochesVendidas[alojamiento * 12 + mes]; }
+    long long getIngresos(int alojamiento, int mes) const { return ingresos[alojamiento * 12 + mes]; }
+    float getOcupacion(int alojamiento, int mes) const;
+
+    // Metodos
+    void agregarReservacion(int alojamiento, int diaEntrada, int noches, long long monto);
+    void calcular(int numHilos = 0);
+};
+
+#endif // ANALITICAOCUPACION_H
@@ -2,10 +2,13 @@
 #include "alojamiento.h"
 #include "sistema.h"
 #include "reservacion.h"
+#include "analiticaocupacion.h"
 #include "medicionrecursos.h"
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -63,6 +66,21 @@ Anfitrion::~Anfitrion() {
     // No es necesario liberar recursos manualmente porque no hay uso de memoria dinámica propia
 }
 
+/**
+ * @brief Cambia la puntuación del anfitrión.
+ *
+ * @param nuevaPuntuacion Puntuación promedio actualizada.
+ *
+ * @throws std::invalid_argument si la puntuación no está en el rango [0.0, 5.0].
+ */
+void Anfitrion::setPuntuacion(float nuevaPuntuacion) {
+    incrementarIteracion();
+    if (nuevaPuntuacion < 0.0f || nuevaPuntuacion > 5.0f) {
+        throw invalid_argument("Puntuacion debe estar entre 0.0 y 5.0");
+    }
+    puntuacion = nuevaPuntuacion;
+}
+
 /**
  * @brief Muestra en consola las reservaciones activas de los alojamientos de un anfitrión.
  *
@@ -431,3 +449,182 @@ void Anfitrion::actualizarHistorico(Sistema* sistema) {
     sistema->procesarActualizacionHistorico(fechaCorte);
     incrementarIteracion();
 }
+
+/**
+ * @brief Muestra la ocupación, las noches vendidas y los ingresos mensuales de los alojamientos del anfitrión.
+ *
+ * Solicita el año del reporte y muestra, por cada alojamiento, una fila por mes con las
+ * noches vendidas, la tasa de ocupación (noches vendidas sobre días del mes) y los ingresos;
+ * al final, los totales del anfitrión. Se incluyen las reservaciones activas y las ya
+ * movidas al histórico (ver `Sistema::calcularOcupacionAnfitrion`).
+ *
+ * @param sistema Puntero al sistema que gestiona alojamientos y reservaciones.
+ */
+void Anfitrion::mostrarOcupacion(Sistema* sistema) {
+    cout << "\n=== OCUPACION E INGRESOS ===\n";
+    cout << "Anfitrion: " << this->getCodigo() << "\n";
+    cout << "Documento: " << this->getDocumento() << "\n\n";
+
+    int anio;
+    cout << "Ingrese el anio del reporte (AAAA): ";
+    cin >> anio;
+    incrementarIteracion();
+
+    if (!cin) {
+        cin.clear();
+        string basura;
+        cin >> basura;
+        cout << "Entrada invalida. Debe ingresar un numero.\n";
+        return;
+    }
+
+    AnaliticaOcupacion* analitica = nullptr;
+    try {
+        analitica = sistema->calcularOcupacionAnfitrion(this->getDocumento(), anio);
+    } catch (const invalid_argument& e) {
+        cout << "Error: " << e.what() << "\n";
+        return;
+    }
+    if (analitica == nullptr || analitica->getNumAlojamientos() == 0) {
+        cout << "No tiene alojamientos registrados.\n";
+        delete analitica;
+        if (analitica != nullptr) agregarMemoria(-static_cast<long long>(sizeof(AnaliticaOcupacion)));
+        return;
+    }
+
+    int cantidad = 0;
+    const int* suyos = sistema->getAlojamientosDeAnfitrion(sistema->buscarIndiceAnfitrion(this->getDocumento()),
+                                                           cantidad);
+    const Alojamiento* alojamientos = sistema->getAlojamientos();
+
+    long long nochesMes[12] = {0};
+    long long ingresosMes[12] = {0};
+
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        const Alojamiento& alojamiento = alojamientos[suyos[i]];
+        cout << "\nAlojamiento " << alojamiento.getCodigo() << " - " << alojamiento.getNombre() << "\n";
+        cout << "Mes       Noches  Ocupacion      Ingresos\n";
+
+        for (int mes = 0; mes < 12; ++mes) {
+            incrementarIteracion();
+            long long noches = analitica->getNochesVendidas(i, mes);
+            long long ingresos = analitica->getIngresos(i, mes);
+            nochesMes[mes] += noches;
+            ingresosMes[mes] += ingresos;
+
+            cout << setw(2) << setfill('0') << mes + 1 << "/" << anio << setfill(' ')
+                 << setw(9) << noches
+                 << setw(10) << fixed << setprecision(1) << analitica->getOcupacion(i, mes) * 100 << "%"
+                 << setw(14) << ingresos << "\n";
+        }
+    }
+
+    cout << "\n=== TOTAL DEL ANFITRION (" << cantidad << " alojamientos) ===\n";
+    cout << "Mes       Noches  Ocupacion      Ingresos\n";
+    long long nochesAnio = 0;
+    long long ingresosAnio = 0;
+    for (int mes = 0; mes < 12; ++mes) {
+        incrementarIteracion();
+        nochesAnio += nochesMes[mes];
+        ingresosAnio += ingresosMes[mes];
+        float ocupacion = static_cast<float>(nochesMes[mes]) / (analitica->getDiasDelMes(mes) * cantidad);
+
+        cout << setw(2) << setfill('0') << mes + 1 << "/" << anio << setfill(' ')
+             << setw(9) << nochesMes[mes]
+             << setw(10) << fixed << setprecision(1) << ocupacion * 100 << "%"
+             << setw(14) << ingresosMes[mes] << "\n";
+    }
+    cout << "Anio: " << nochesAnio << " noches vendidas, $" << ingresosAnio << " en ingresos.\n\n";
+
+    delete analitica;
+    agregarMemoria(-static_cast<long long>(sizeof(AnaliticaOcupacion)));
+
+    cout << "Presione Enter para continuar...";
+    cin.ignore();
+    cin.get();
+}
+
+/**
+ * @brief Muestra el calendario de ocupación de un mes para los alojamientos del anfitrión.
+ *
+ * Solicita el mes y el año y muestra una fila por alojamiento con una marca por día
+ * ('#' noche ocupada, '.' libre) y las noches ocupadas del mes. Los mapas de ocupación salen
+ * de `Sistema::obtenerCalendarioAnfitrion`; todo el calendario se arma en un búfer y se
+ * escribe en pantalla de una sola vez.
+ *
+ * @param sistema Puntero al sistema que gestiona alojamientos y reservaciones.
+ */
+void Anfitrion::mostrarCalendario(Sistema* sistema) {
+    int mes, anio;
+    cout << "\n=== CALENDARIO DE OCUPACION ===\n";
+    cout << "Ingrese el mes (1-12): ";
+    cin >> mes;
+    cout << "Ingrese el anio (AAAA): ";
+    cin >> anio;
+    incrementarIteracion();
+
+    if (!cin) {
+        cin.clear();
+        string basura;
+        cin >> basura;
+        cout << "Entrada invalida. Debe ingresar un numero.\n";
+        return;
+    }
+
+    int cantidad = 0;
+    unsigned int* mapas = nullptr;
+    try {
+        mapas = sistema->obtenerCalendarioAnfitrion(this->getDocumento(), mes, anio, cantidad);
+    } catch (const invalid_argument& e) {
+        cout << "Error: " << e.what() << "\n";
+        return;
+    }
+    if (mapas == nullptr) {
+        cout << "No tiene alojamientos registrados.\n";
+        return;
+    }
+
+    int cantidadSuyos = 0;
+    const int* suyos = sistema->getAlojamientosDeAnfitrion(sistema->buscarIndiceAnfitrion(this->getDocumento()),
+                                                           cantidadSuyos);
+    const Alojamiento* alojamientos = sistema->getAlojamientos();
+    int inicioMes = Fecha(1, mes, anio).aDiasDesdeFechaBase();
+    int dias = Fecha(1, mes % 12 + 1, anio + mes / 12).aDiasDesdeFechaBase() - inicioMes;
+
+    ostringstream salida;
+    salida << "\nAnfitrion: " << this->getCodigo() << "   Mes: " << setw(2) << setfill('0') << mes
+           << "/" << anio << setfill(' ') << "\n\n";
+
+    // Encabezado: decenas y unidades del dia del mes
+    salida << left << setw(14) << "" << right;
+    for (int d = 1; d <= dias; ++d) salida << (d >= 10 ? static_cast<char>('0' + d / 10) : ' ');
+    salida << "\n" << left << setw(14) << "Alojamiento" << right;
+    for (int d = 1; d <= dias; ++d) salida << static_cast<char>('0' + d % 10);
+    salida << setw(8) << "Noches" << setw(11) << "Ocupacion" << "\n";
+
+    int nochesTotales = 0;
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        int noches = 0;
+        salida << left << setw(14) << alojamientos[suyos[i]].getCodigo() << right;
+        for (int d = 0; d < dias; ++d) {
+            bool ocupada = (mapas[i] >> d) & 1u;
+            noches += ocupada ? 1 : 0;
+            salida << (ocupada ? '#' : '.');
+        }
+        nochesTotales += noches;
+        salida << setw(8) << noches << setw(10) << fixed << setprecision(1)
+               << 100.0 * noches / dias << "%\n";
+    }
+    salida << "\nTotal: " << nochesTotales << " noches ocupadas de " << dias * cantidad
+           << " ('#' ocupada, '.' libre)\n\n";
+    cout << salida.str();
+
+    delete[] mapas;
+    agregarMemoria(-static_cast<long long>(sizeof(unsigned int) * cantidad));
+
+    cout << "Presione Enter para continuar...";
+    cin.ignore();
+    cin.get();
+}
@@ -32,9 +32,14 @@ public:
     int getAntiguedad() const { return antiguedad; }
     float getPuntuacion() const { return puntuacion; }
 
+    // Setters
+    void setPuntuacion(float nuevaPuntuacion);
+
     void mostrarReservacionesActivas(Sistema* sistema);
     void cancelarReservacion(Sistema* sistema);
     void actualizarHistorico(Sistema* sistema);
+    void mostrarOcupacion(Sistema* sistema);
+    void mostrarCalendario(Sistema* sistema);
 
 };
 
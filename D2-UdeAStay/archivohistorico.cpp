@@ -0,0 +1,1556 @@
+#include "archivohistorico.h"
+#include "gestionarchivos.h"
+#include "reservacion.h"
+#include "fecha.h"
+#include "indicehash.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+// Columnas de cada grupo del formato columnar, en el orden en que se escriben
+const int COLUMNA_ENTRADA = 0;      // Dias de entrada: diferencia con la fila anterior (varint)
+const int COLUMNA_DURACION = 1;     // Noches (varint)
+const int COLUMNA_MONTO = 2;        // Monto en pesos (8 bytes, little-endian)
+const int COLUMNA_ALOJAMIENTO = 3;  // Diccionario de codigos y posicion de cada fila (varint)
+const int COLUMNA_DOCUMENTO = 4;    // Diccionario de documentos y posicion de cada fila (varint)
+const int COLUMNA_METODO = 5;       // Un byte por fila
+const int COLUMNA_PAGO = 6;         // Dias entre entrada y pago (zigzag + 1) o 0 y el texto original
+const int COLUMNA_CODIGO = 7;       // Texto (longitud varint y bytes)
+const int COLUMNA_ANOTACION = 8;    // Texto (longitud varint y bytes)
+const int COLUMNA_TEXTO_ENTRADA = 9;  // Texto original de la entrada, vacio si coincide con la fecha reconstruida
+const int NUM_COLUMNAS = 10;
+
+// Marca al inicio de cada grupo columnar (cambia si cambian las columnas)
+const char MARCA_GRUPO_COLUMNAR[4] = {'U', 'H', 'C', '2'};
+
+// Bytes de la cabecera de un grupo: marca, filas, dia minimo, dia maximo y longitud de cada columna
+const int BYTES_CABECERA_GRUPO = 4 + 4 * (3 + NUM_COLUMNAS);
+
+/**
+ * @brief Agrega un entero de ancho fijo en orden little-endian (byte menos significativo primero).
+ *
+ * El orden se fija aquí y no depende de la plataforma, así un archivo ".col" se lee igual
+ * en cualquier máquina.
+ *
+ * @param destino Bytes donde se escribe.
+ * @param valor Valor a escribir (se toman sus `bytes` bytes menos significativos).
+ * @param bytes Ancho del entero: 4 u 8.
+ */
+static void escribirFijo(string& destino, unsigned long long valor, int bytes) {
+    for (int b = 0; b < bytes; ++b) {
+        destino += static_cast<char>((valor >> (8 * b)) & 0xFF);
+    }
+}
+
+/**
+ * @brief Lee un entero escrito con `escribirFijo`.
+ *
+ * @param origen Primer byte del entero.
+ * @param bytes Ancho del entero: 4 u 8.
+ * @return Valor leído, sin extender el signo.
+ */
+static unsigned long long leerFijo(const char* origen, int bytes) {
+    unsigned long long valor = 0;
+    for (int b = 0; b < bytes; ++b) {
+        valor |= static_cast<unsigned long long>(static_cast<unsigned char>(origen[b])) << (8 * b);
+    }
+    return valor;
+}
+
+/**
+ * @brief Agrega un entero sin signo de longitud variable (7 bits por byte).
+ *
+ * @param destino Columna donde se escribe.
+ * @param valor Valor a escribir.
+ */
+static void escribirVarint(string& destino, unsigned long long valor) {
+    while (valor >= 0x80) {
+        destino += static_cast<char>((valor & 0x7F) | 0x80);
+        valor >>= 7;
+    }
+    destino += static_cast<char>(valor);
+}
+
+/**
+ * @brief Lee un entero escrito con `escribirVarint`.
+ *
+ * @param origen Columna leída.
+ * @param pos [in/out] Posición del primer byte; queda después del último.
+ * @return Valor leído (0 si la columna se acaba).
+ */
+static unsigned long long leerVarint(const string& origen, size_t& pos) {
+    unsigned long long valor = 0;
+    int desplazamiento = 0;
+    while (pos < origen.size() && desplazamiento < 64) {
+        unsigned char byte = static_cast<unsigned char>(origen[pos++]);
+        valor |= static_cast<unsigned long long>(byte & 0x7F) << desplazamiento;
+        if ((byte & 0x80) == 0) break;
+        desplazamiento += 7;
+    }
+    return valor;
+}
+
+/**
+ * @brief Agrega un texto precedido por su longitud.
+ *
+ * @param destino Columna donde se escribe.
+ * @param texto Texto a escribir.
+ */
+static void escribirTexto(string& destino, const string& texto) {
+    escribirVarint(destino, texto.size());
+    destino += texto;
+}
+
+/**
+ * @brief Lee un texto escrito con `escribirTexto`.
+ *
+ * @param origen Columna leída.
+ * @param pos [in/out] Posición de la longitud; queda después del texto.
+ * @return Texto leído.
+ */
+static string leerTexto(const string& origen, size_t& pos) {
+    size_t longitud = static_cast<size_t>(leerVarint(origen, pos));
+    longitud = min(longitud, origen.size() - pos);
+    string texto = origen.substr(pos, longitud);
+    pos += longitud;
+    return texto;
+}
+
+/**
+ * @brief Codifica una columna de texto con diccionario.
+ *
+ * La columna queda como: cantidad de valores distintos, cada valor (en orden de aparición)
+ * y, por cada fila, la posición de su valor en el diccionario.
+ *
+ * @param valores Valor de cada fila.
+ * @param filas Cantidad de filas.
+ * @param destino Columna donde se escribe.
+ */
+static void codificarDiccionario(const string* valores, int filas, string& destino) {
+    IndiceHash posiciones;
+    posiciones.reservar(filas);
+    int* codigos = new int[filas];
+    agregarMemoria(sizeof(int) * filas);
+
+    string diccionario;
+    int numValores = 0;
+    for (int i = 0; i < filas; ++i) {
+        incrementarIteracion();
+        int codigo = posiciones.buscar(valores[i]);
+        if (codigo < 0) {
+            codigo = numValores++;
+            posiciones.insertar(valores[i], codigo);
+            escribirTexto(diccionario, valores[i]);
+        }
+        codigos[i] = codigo;
+    }
+
+    escribirVarint(destino, numValores);
+    destino += diccionario;
+    for (int i = 0; i < filas; ++i) {
+        incrementarIteracion();
+        escribirVarint(destino, codigos[i]);
+    }
+
+    delete[] codigos;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * filas));
+}
+
+/**
+ * @brief Decodifica una columna escrita con `codificarDiccionario`.
+ *
+ * @param origen Columna leída.
+ * @param filas Cantidad de filas del grupo.
+ * @param numValores [out] Cantidad de valores del diccionario.
+ * @param codigos [out] Posición en el diccionario de cada fila (nullptr para no leerlas).
+ * @return Diccionario (el llamador lo libera con delete[]).
+ */
+static string* decodificarDiccionario(const string& origen, int filas, int& numValores, int* codigos) {
+    size_t pos = 0;
+    numValores = static_cast<int>(leerVarint(origen, pos));
+    string* diccionario = new string[numValores > 0 ? numValores : 1];
+    agregarMemoria(sizeof(string) * numValores);
+
+    for (int i = 0; i < numValores; ++i) {
+        incrementarIteracion();
+        diccionario[i] = leerTexto(origen, pos);
+    }
+    for (int i = 0; codigos != nullptr && i < filas; ++i) {
+        incrementarIteracion();
+        int codigo = static_cast<int>(leerVarint(origen, pos));
+        codigos[i] = (codigo < numValores) ? codigo : 0;
+    }
+    return diccionario;
+}
+
+/**
+ * @brief Posición de un valor en el diccionario de una columna.
+ *
+ * @param origen Columna leída.
+ * @param valor Valor buscado.
+ * @return Posición del valor, o -1 si ninguna fila del grupo lo tiene.
+ */
+static int buscarEnDiccionario(const string& origen, const string& valor) {
+    int numValores = 0;
+    string* diccionario = decodificarDiccionario(origen, 0, numValores, nullptr);
+    int posicion = -1;
+    for (int i = 0; i < numValores && posicion < 0; ++i) {
+        incrementarIteracion();
+        if (diccionario[i] == valor) posicion = i;
+    }
+    delete[] diccionario;
+    agregarMemoria(-static_cast<long long>(sizeof(string) * numValores));
+    return posicion;
+}
+
+/**
+ * @brief Decodifica los días de entrada de un grupo columnar.
+ *
+ * @param origen Columna de entradas.
+ * @param filas Cantidad de filas.
+ * @param diaMin Día de entrada mínimo del grupo (base de la primera diferencia).
+ * @param dias [out] Día de entrada de cada fila.
+ */
+static void decodificarEntradas(const string& origen, int filas, int diaMin, int* dias) {
+    size_t pos = 0;
+    int dia = diaMin;
+    for (int i = 0; i < filas; ++i) {
+        incrementarIteracion();
+        dia += static_cast<int>(leerVarint(origen, pos));
+        dias[i] = dia;
+    }
+}
+
+/**
+ * @brief Lee la cabecera de un grupo columnar.
+ *
+ * Los enteros de la cabecera son de 4 bytes en little-endian (ver `escribirFijo`).
+ *
+ * @param archivo Archivo del segmento, posicionado al inicio del grupo.
+ * @param filas [out] Cantidad de filas.
+ * @param diaMin [out] Día de entrada mínimo.
+ * @param diaMax [out] Día de entrada máximo.
+ * @param longitudes [out] Bytes de cada una de las NUM_COLUMNAS columnas.
+ * @return true si se leyó una cabecera válida; false al final del archivo o si está dañado.
+ */
+static bool leerCabeceraGrupo(ifstream& archivo, int& filas, int& diaMin, int& diaMax, int* longitudes) {
+    char cabecera[BYTES_CABECERA_GRUPO];
+    if (!archivo.read(cabecera, BYTES_CABECERA_GRUPO) || memcmp(cabecera, MARCA_GRUPO_COLUMNAR, 4) != 0) {
+        return false;
+    }
+
+    filas = static_cast<int>(static_cast<unsigned int>(leerFijo(cabecera + 4, 4)));
+    diaMin = static_cast<int>(static_cast<unsigned int>(leerFijo(cabecera + 8, 4)));
+    diaMax = static_cast<int>(static_cast<unsigned int>(leerFijo(cabecera + 12, 4)));
+    for (int c = 0; c < NUM_COLUMNAS; ++c) {
+        longitudes[c] = static_cast<int>(static_cast<unsigned int>(leerFijo(cabecera + 16 + 4 * c, 4)));
+    }
+    return filas >= 0;
+}
+
+/**
+ * @brief Lee una sola columna de un grupo columnar, saltando las anteriores.
+ *
+ * @param archivo Archivo del segmento.
+ * @param inicioDatos Posición del primer byte de la primera columna del grupo.
+ * @param longitudes Bytes de cada columna.
+ * @param columna Columna a leer.
+ * @param destino [out] Bytes de la columna.
+ * @return true si se leyó completa.
+ */
+static bool leerColumna(ifstream& archivo, long long inicioDatos, const int* longitudes, int columna,
+                        string& destino) {
+    long long posicion = inicioDatos;
+    for (int c = 0; c < columna; ++c) {
+        posicion += longitudes[c];
+    }
+    destino.assign(static_cast<size_t>(max(longitudes[columna], 0)), '\0');
+    archivo.clear();
+    archivo.seekg(posicion);
+    return static_cast<bool>(archivo.read(&destino[0], static_cast<streamsize>(destino.size())));
+}
+
+/**
+ * @brief Agrega una reservación al arreglo de resultados de una consulta.
+ *
+ * @param resultado [in/out] Arreglo de resultados (crece al doble cuando se llena).
+ * @param cantidad [in/out] Cantidad de reservaciones en `resultado`.
+ * @param capacidad [in/out] Capacidad de `resultado`.
+ * @param reservacion Reservación a agregar.
+ */
+static void agregarResultado(Reservacion*& resultado, int& cantidad, int& capacidad,
+                             const Reservacion& reservacion) {
+    if (cantidad >= capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? ArchivoHistorico::LINEAS_POR_BLOQUE : capacidad * 2;
+        Reservacion* nuevo = new Reservacion[nuevaCapacidad];
+        agregarMemoria(sizeof(Reservacion) * nuevaCapacidad);
+        for (int i = 0; i < cantidad; ++i) {
+            incrementarIteracion();
+            nuevo[i] = resultado[i];
+        }
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * capacidad));
+        delete[] resultado;
+        resultado = nuevo;
+        capacidad = nuevaCapacidad;
+    }
+    resultado[cantidad++] = reservacion;
+}
+
+/**
+ * @brief Agrega una fila numérica al arreglo de resultados de `leerFilas`.
+ *
+ * @param resultado [in/out] Arreglo de filas (crece al doble cuando se llena).
+ * @param cantidad [in/out] Cantidad de filas en `resultado`.
+ * @param capacidad [in/out] Capacidad de `resultado`.
+ * @param fila Fila a agregar.
+ */
+static void agregarFila(FilaHistorica*& resultado, int& cantidad, int& capacidad, const FilaHistorica& fila) {
+    if (cantidad >= capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? ArchivoHistorico::LINEAS_POR_BLOQUE : capacidad * 2;
+        FilaHistorica* nuevo = new FilaHistorica[nuevaCapacidad];
+        agregarMemoria(sizeof(FilaHistorica) * nuevaCapacidad);
+        for (int i = 0; i < cantidad; ++i) {
+            incrementarIteracion();
+            nuevo[i] = resultado[i];
+        }
+        agregarMemoria(-static_cast<long long>(sizeof(FilaHistorica) * capacidad));
+        delete[] resultado;
+        resultado = nuevo;
+        capacidad = nuevaCapacidad;
+    }
+    resultado[cantidad++] = fila;
+}
+
+/**
+ * @brief Constructor de la clase ArchivoHistorico.
+ *
+ * @param prefijo Nombre base de los archivos. El catálogo de segmentos es `prefijo + ".idx"`,
+ *                cada segmento `prefijo_AAAA-MM.txt` y su índice `prefijo_AAAA-MM.idx`
+ *                (en formato columnar, `prefijo_AAAA-MM.col`).
+ */
+ArchivoHistorico::ArchivoHistorico(const string& prefijo) : prefijo(prefijo), columnar(false) {}
+
+/**
+ * @brief Obtiene el segmento (mes) al que pertenece una fecha de entrada.
+ *
+ * @param fechaEntrada Fecha de entrada de la reservación.
+ * @return Número del segmento: anio * 12 + mes - 1 (crece con el tiempo).
+ */
+int ArchivoHistorico::segmentoDe(const Fecha& fechaEntrada) {
+    return fechaEntrada.getAnio() * 12 + fechaEntrada.getMes() - 1;
+}
+
+/**
+ * @brief Construye el nombre de un archivo de segmento.
+ *
+ * @param segmento Número del segmento.
+ * @param extension ".txt" para los datos, ".idx" para su índice o ".col" para el formato columnar.
+ * @return Nombre del archivo, por ejemplo "HistoricoReservaciones_2025-03.txt".
+ */
+string ArchivoHistorico::nombreSegmento(int segmento, const string& extension) const {
+    return prefijo + "_" + textoSegmento(segmento) + extension;
+}
+
+/**
+ * @brief Representa un segmento como texto, tal como aparece en los nombres y en los índices.
+ *
+ * @param segmento Número del segmento.
+ * @return Texto "AAAA-MM".
+ */
+string ArchivoHistorico::textoSegmento(int segmento) {
+    ostringstream texto;
+    texto << segmento / 12 << "-" << setw(2) << setfill('0') << segmento % 12 + 1;
+    return texto.str();
+}
+
+/**
+ * @brief Nombre del índice general por huésped.
+ *
+ * @return `prefijo + "_huespedes.idx"`: una línea "documento|AAAA-MM,AAAA-MM,..." por huésped.
+ */
+string ArchivoHistorico::nombreIndiceHuespedes() const {
+    return prefijo + "_huespedes.idx";
+}
+
+/**
+ * @brief Agrega al índice general por huésped los segmentos de un lote de reservaciones.
+ *
+ * El índice puede listar de más (un segmento sin reservaciones del huésped solo cuesta
+ * revisarlo), pero nunca de menos. Solo agrega el lote: si el índice no existe y el catálogo
+ * ya tiene segmentos, `guardar` lo reconstruye antes con todas las reservaciones guardadas.
+ *
+ * @param reservaciones Reservaciones del lote.
+ * @param segmentoDeReservacion Segmento de cada reservación del lote.
+ * @param cantidad Cantidad de reservaciones del lote.
+ * @return true si el índice se escribió.
+ */
+bool ArchivoHistorico::actualizarIndiceHuespedes(const Reservacion* reservaciones, const int* segmentoDeReservacion,
+                                                 int cantidad) const {
+    ifstream entrada(nombreIndiceHuespedes());
+    int lineas = 0;
+    string linea;
+    while (getline(entrada, linea)) {
+        incrementarIteracion();
+        lineas++;
+    }
+
+    int capacidad = lineas + cantidad;
+    string* documentos = new string[capacidad];
+    string* listas = new string[capacidad];
+    agregarMemoria(sizeof(string) * 2 * capacidad);
+
+    IndiceHash posicionDocumento;
+    posicionDocumento.reservar(capacidad);
+    int numDocumentos = 0;
+
+    entrada.clear();
+    entrada.seekg(0);
+    while (numDocumentos < lineas && getline(entrada, linea)) {
+        incrementarIteracion();
+        size_t separador = linea.find('|');
+        if (separador == string::npos) continue;
+        documentos[numDocumentos] = linea.substr(0, separador);
+        listas[numDocumentos] = "," + linea.substr(separador + 1) + ",";
+        posicionDocumento.insertar(documentos[numDocumentos], numDocumentos);
+        numDocumentos++;
+    }
+    entrada.close();
+
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        const string& documento = reservaciones[i].getDocumento();
+        int pos = posicionDocumento.buscar(documento);
+        if (pos < 0) {
+            pos = numDocumentos++;
+            documentos[pos] = documento;
+            listas[pos] = ",";
+            posicionDocumento.insertar(documento, pos);
+        }
+        string token = textoSegmento(segmentoDeReservacion[i]) + ",";
+        if (listas[pos].find("," + token) == string::npos) {
+            listas[pos] += token;
+        }
+    }
+
+    ofstream salida(nombreIndiceHuespedes());
+    for (int i = 0; i < numDocumentos; ++i) {
+        incrementarIteracion();
+        salida << documentos[i] << '|' << listas[i].substr(1, listas[i].size() - 2) << '\n';
+    }
+    bool exito = salida.good();
+
+    delete[] documentos;
+    delete[] listas;
+    agregarMemoria(-static_cast<long long>(sizeof(string) * 2 * capacidad));
+    return exito;
+}
+
+/**
+ * @brief Busca en el índice general los segmentos donde aparece un huésped.
+ *
+ * Solo se lee el índice por huésped (una línea por documento), no los segmentos.
+ *
+ * @param documentoHuesped Documento del huésped.
+ * @param lista [out] Segmentos "AAAA-MM" separados por comas (vacío si el huésped no tiene histórico).
+ * @return true si el índice existe; false si hay que revisar todos los segmentos.
+ */
+bool ArchivoHistorico::segmentosDeHuesped(const string& documentoHuesped, string& lista) const {
+    lista.clear();
+    ifstream archivo(nombreIndiceHuespedes());
+    if (!archivo.is_open()) return false;
+
+    const string clave = documentoHuesped + "|";
+    string linea;
+    while (getline(archivo, linea)) {
+        incrementarIteracion();
+        if (linea.compare(0, clave.size(), clave) == 0) {
+            lista = linea.substr(clave.size());
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Cuenta los segmentos registrados en el catálogo.
+ *
+ * @return Cantidad de líneas del catálogo (0 si aún no existe).
+ */
+int ArchivoHistorico::contarSegmentos() const {
+    ifstream archivo(prefijo + ".idx");
+    int total = 0;
+    string linea;
+    while (getline(archivo, linea)) {
+        incrementarIteracion();
+        total += linea.empty() ? 0 : 1;
+    }
+    return total;
+}
+
+/**
+ * @brief Lee el catálogo de segmentos: una línea "AAAA-MM|cantidad" por segmento, en orden.
+ *
+ * @param segmentos [out] Números de segmento.
+ * @param cantidades [out] Reservaciones guardadas en cada segmento.
+ * @param capacidad Capacidad de los arreglos (ver `contarSegmentos`).
+ * @return Cantidad de segmentos leídos.
+ */
+int ArchivoHistorico::cargarCatalogo(int* segmentos, int* cantidades, int capacidad) const {
+    ifstream archivo(prefijo + ".idx");
+    int numSegmentos = 0;
+    string linea;
+
+    while (numSegmentos < capacidad && getline(archivo, linea)) {
+        incrementarIteracion();
+        istringstream ss(linea);
+        int anio, mes, cantidad;
+        char guion, separador;
+        if (ss >> anio >> guion >> mes >> separador >> cantidad) {
+            segmentos[numSegmentos] = anio * 12 + mes - 1;
+            cantidades[numSegmentos] = cantidad;
+            numSegmentos++;
+        }
+    }
+    return numSegmentos;
+}
+
+/**
+ * @brief Reescribe el catálogo de segmentos.
+ *
+ * @param segmentos Números de segmento, en orden creciente.
+ * @param cantidades Reservaciones guardadas en cada segmento.
+ * @param numSegmentos Cantidad de segmentos.
+ * @return true si se pudo escribir el archivo.
+ */
+bool ArchivoHistorico::guardarCatalogo(const int* segmentos, const int* cantidades, int numSegmentos) const {
+    ofstream archivo(prefijo + ".idx");
+    if (!archivo.is_open()) return false;
+
+    for (int i = 0; i < numSegmentos; ++i) {
+        incrementarIteracion();
+        archivo << textoSegmento(segmentos[i]) << "|" << cantidades[i] << "\n";
+    }
+    return archivo.good();
+}
+
+/**
+ * @brief Agrega reservaciones al final de un segmento y actualiza su índice disperso.
+ *
+ * Las reservaciones se escriben en bloques de `LINEAS_POR_BLOQUE` líneas. Por cada bloque el
+ * índice guarda la posición en bytes de su primera línea, cuántas líneas tiene y el rango de
+ * días de entrada ("B|posicion|lineas|diaMin|diaMax"); además, cada huésped ("H|documento|...")
+ * y cada alojamiento ("A|codigo|...") tiene la lista de bloques donde aparece. El índice se
+ * reescribe completo, los datos solo se agregan.
+ *
+ * @param segmento Número del segmento.
+ * @param reservaciones Arreglo de reservaciones a guardar.
+ * @param orden Posiciones en `reservaciones` de las que van a este segmento, por día de entrada.
+ * @param diasEntrada Día de entrada de cada reservación (indexado como `reservaciones`).
+ * @param cantidad Cantidad de posiciones en `orden`.
+ * @param fechaCorte Fecha de corte que se anota en el comentario del lote.
+ * @return true si se escribieron los datos y el índice.
+ */
+bool ArchivoHistorico::agregarASegmento(int segmento, const Reservacion* reservaciones, const int* orden,
+                                        const int* diasEntrada, int cantidad, const string& fechaCorte) const {
+    const string nombreDatos = nombreSegmento(segmento, ".txt");
+    const string nombreIndice = nombreSegmento(segmento, ".idx");
+
+    // 1. Indice actual: los bloques se conservan como texto y las listas se cargan por clave
+    ifstream entradaIndice(nombreIndice);
+    int lineasIndice = 0;
+    string linea;
+    while (getline(entradaIndice, linea)) {
+        incrementarIteracion();
+        lineasIndice++;
+    }
+
+    int capacidadClaves = lineasIndice + 2 * cantidad;
+    string* claves = new string[capacidadClaves];
+    string* listas = new string[capacidadClaves];
+    int* ultimoBloque = new int[capacidadClaves];
+    agregarMemoria((sizeof(string) * 2 + sizeof(int)) * capacidadClaves);
+
+    IndiceHash posicionClave;
+    posicionClave.reservar(capacidadClaves);
+    int numClaves = 0;
+    int numBloques = 0;
+    string bloques;
+
+    entradaIndice.clear();
+    entradaIndice.seekg(0);
+    while (getline(entradaIndice, linea)) {
+        incrementarIteracion();
+        if (linea.empty()) continue;
+        if (linea[0] == 'B') {
+            bloques += linea;
+            bloques += '\n';
+            numBloques++;
+            continue;
+        }
+        size_t separador = linea.find('|', 2);
+        if (separador == string::npos) continue;
+
+        claves[numClaves] = linea.substr(0, separador);
+        listas[numClaves] = linea.substr(separador + 1);
+        ultimoBloque[numClaves] = -1;
+        posicionClave.insertar(claves[numClaves], numClaves);
+        numClaves++;
+    }
+    entradaIndice.close();
+
+    // 2. Las nuevas lineas empiezan al final actual del segmento
+    long long desplazamiento = 0;
+    {
+        ifstream existente(nombreDatos, ios::binary | ios::ate);
+        if (existente) desplazamiento = existente.tellg();
+    }
+
+    bool exito = false;
+    ofstream datos(nombreDatos, ios::app | ios::binary);
+    if (datos.is_open()) {
+        string cabecera = "# Corte " + fechaCorte + ": " + to_string(cantidad) + " reservaciones\n";
+        datos << cabecera;
+        desplazamiento += static_cast<long long>(cabecera.size());
+
+        // 3. Bloques nuevos y sus entradas en las listas de huespedes y alojamientos
+        for (int inicio = 0; inicio < cantidad; inicio += LINEAS_POR_BLOQUE) {
+            int fin = min(inicio + LINEAS_POR_BLOQUE, cantidad);
+            int bloque = numBloques++;
+            long long inicioBloque = desplazamiento;
+            int diaMin = INT_MAX;
+            int diaMax = INT_MIN;
+
+            for (int k = inicio; k < fin; ++k) {
+                incrementarIteracion();
+                const Reservacion& reservacion = reservaciones[orden[k]];
+                string texto = GestionArchivos::formatearLineaReservacion(reservacion) + "\n";
+                datos << texto;
+                desplazamiento += static_cast<long long>(texto.size());
+                diaMin = min(diaMin, diasEntrada[orden[k]]);
+                diaMax = max(diaMax, diasEntrada[orden[k]]);
+
+                const string clavesLinea[2] = {"H|" + reservacion.getDocumento(),
+                                               "A|" + reservacion.getCodigoAlojamiento()};
+                for (int c = 0; c < 2; ++c) {
+                    int pos = posicionClave.buscar(clavesLinea[c]);
+                    if (pos < 0) {
+                        pos = numClaves++;
+                        claves[pos] = clavesLinea[c];
+                        ultimoBloque[pos] = -1;
+                        posicionClave.insertar(claves[pos], pos);
+                    }
+                    if (ultimoBloque[pos] != bloque) {
+                        if (!listas[pos].empty()) listas[pos] += ',';
+                        listas[pos] += to_string(bloque);
+                        ultimoBloque[pos] = bloque;
+                    }
+                }
+            }
+
+            bloques += "B|" + to_string(inicioBloque) + "|" + to_string(fin - inicio) + "|" +
+                       to_string(diaMin) + "|" + to_string(diaMax) + "\n";
+        }
+        datos.close();
+        exito = !datos.fail();
+    }
+
+    // 4. Reescribir el indice del segmento
+    if (exito) {
+        ofstream salidaIndice(nombreIndice);
+        salidaIndice << bloques;
+        for (int i = 0; i < numClaves; ++i) {
+            incrementarIteracion();
+            salidaIndice << claves[i] << '|' << listas[i] << '\n';
+        }
+        exito = salidaIndice.good();
+    }
+
+    delete[] claves;
+    delete[] listas;
+    delete[] ultimoBloque;
+    agregarMemoria(-static_cast<long long>((sizeof(string) * 2 + sizeof(int)) * capacidadClaves));
+    return exito;
+}
+
+/**
+ * @brief Agrega reservaciones a un segmento como un grupo en formato columnar.
+ *
+ * El grupo empieza con una cabecera (marca, filas, rango de días de entrada y bytes de cada
+ * columna) seguida de las columnas: días de entrada como diferencias, códigos de alojamiento
+ * y documentos con diccionario, y montos de ancho fijo. Así un reporte lee solo las columnas
+ * que usa y salta el resto con la longitud de la cabecera. Los enteros de ancho fijo
+ * (cabecera y montos) se escriben en little-endian, sin importar la plataforma.
+ *
+ * Las fechas de entrada y de pago se guardan como días; si el texto original no es el que
+ * da `Fecha::toString` (por ejemplo "1/2/2025"), se guarda también el texto para que la
+ * consulta devuelva la línea tal como estaba en Reservaciones.txt.
+ *
+ * @param segmento Número del segmento.
+ * @param reservaciones Arreglo de reservaciones a guardar.
+ * @param orden Posiciones en `reservaciones` de las que van a este segmento, por día de entrada.
+ * @param diasEntrada Día de entrada de cada reservación (indexado como `reservaciones`).
+ * @param cantidad Cantidad de posiciones en `orden`.
+ * @return true si se escribió el grupo completo.
+ */
+bool ArchivoHistorico::agregarASegmentoColumnar(int segmento, const Reservacion* reservaciones, const int* orden,
+                                                const int* diasEntrada, int cantidad) const {
+    string columnas[NUM_COLUMNAS];
+    string* codigosAlojamiento = new string[cantidad];
+    string* documentos = new string[cantidad];
+    agregarMemoria(sizeof(string) * 2 * cantidad);
+
+    int diaMin = diasEntrada[orden[0]];
+    int diaMax = diasEntrada[orden[cantidad - 1]];
+    int diaAnterior = diaMin;
+
+    for (int k = 0; k < cantidad; ++k) {
+        incrementarIteracion();
+        const Reservacion& reservacion = reservaciones[orden[k]];
+        int dia = diasEntrada[orden[k]];
+
+        escribirVarint(columnas[COLUMNA_ENTRADA], static_cast<unsigned long long>(dia - diaAnterior));
+        diaAnterior = dia;
+
+        escribirVarint(columnas[COLUMNA_DURACION], static_cast<unsigned long long>(max(reservacion.getDuracion(), 0)));
+
+        escribirFijo(columnas[COLUMNA_MONTO], static_cast<unsigned long long>(llround(reservacion.getMonto())), 8);
+
+        codigosAlojamiento[k] = reservacion.getCodigoAlojamiento();
+        documentos[k] = reservacion.getDocumento();
+        columnas[COLUMNA_METODO] += reservacion.getMetodoPago();
+
+        // La fecha de pago se guarda como dias desde la entrada si se puede reconstruir igual
+        Fecha pago(reservacion.getFechaPago());
+        if (pago.esValida() && pago.toString() == reservacion.getFechaPago()) {
+            long long diferencia = pago.aDiasDesdeFechaBase() - dia;
+            unsigned long long zigzag = (static_cast<unsigned long long>(diferencia) << 1) ^
+                                        static_cast<unsigned long long>(diferencia >> 63);
+            escribirVarint(columnas[COLUMNA_PAGO], zigzag + 1);
+        } else {
+            escribirVarint(columnas[COLUMNA_PAGO], 0);
+            escribirTexto(columnas[COLUMNA_PAGO], reservacion.getFechaPago());
+        }
+
+        escribirTexto(columnas[COLUMNA_CODIGO], reservacion.getCodigo());
+        escribirTexto(columnas[COLUMNA_ANOTACION], reservacion.getAnotacion());
+
+        const string& entrada = reservacion.getFechaEntrada();
+        escribirTexto(columnas[COLUMNA_TEXTO_ENTRADA],
+                      (Fecha::desdeDiasFechaBase(dia).toString() == entrada) ? string() : entrada);
+    }
+    codificarDiccionario(codigosAlojamiento, cantidad, columnas[COLUMNA_ALOJAMIENTO]);
+    codificarDiccionario(documentos, cantidad, columnas[COLUMNA_DOCUMENTO]);
+
+    delete[] codigosAlojamiento;
+    delete[] documentos;
+    agregarMemoria(-static_cast<long long>(sizeof(string) * 2 * cantidad));
+
+    ofstream datos(nombreSegmento(segmento, ".col"), ios::app | ios::binary);
+    if (!datos.is_open()) return false;
+
+    string cabecera(MARCA_GRUPO_COLUMNAR, 4);
+    escribirFijo(cabecera, static_cast<unsigned int>(cantidad), 4);
+    escribirFijo(cabecera, static_cast<unsigned int>(diaMin), 4);
+    escribirFijo(cabecera, static_cast<unsigned int>(diaMax), 4);
+    for (int c = 0; c < NUM_COLUMNAS; ++c) {
+        escribirFijo(cabecera, static_cast<unsigned int>(columnas[c].size()), 4);
+    }
+    datos.write(cabecera.data(), static_cast<streamsize>(cabecera.size()));
+    for (int c = 0; c < NUM_COLUMNAS; ++c) {
+        datos.write(columnas[c].data(), static_cast<streamsize>(columnas[c].size()));
+    }
+    datos.close();
+    return !datos.fail();
+}
+
+/**
+ * @brief Guarda reservaciones finalizadas en los segmentos del histórico.
+ *
+ * Las reservaciones se reparten por mes de entrada; dentro de cada segmento se escriben
+ * ordenadas por día de entrada, en texto con índice disperso o como un grupo columnar
+ * según `esColumnar`. Al final se actualiza el catálogo de segmentos. Si el índice por
+ * huésped no existe pero ya hay segmentos (un histórico anterior a ese índice), primero se
+ * reconstruye con todas las reservaciones guardadas.
+ *
+ * @param reservaciones Arreglo de reservaciones a guardar.
+ * @param cantidad Cantidad de reservaciones.
+ * @param fechaCorte Fecha de corte que se anota en cada segmento modificado (solo en texto).
+ * @return true si todos los segmentos y el catálogo se escribieron; false si falló alguno.
+ */
+bool ArchivoHistorico::guardar(const Reservacion* reservaciones, int cantidad, const string& fechaCorte) const {
+    if (cantidad <= 0) return true;
+
+    // 1. Segmento y dia de entrada de cada reservacion, ordenadas por (segmento, dia)
+    int* segmentoDeReservacion = new int[cantidad];
+    int* diasEntrada = new int[cantidad];
+    int* orden = new int[cantidad];
+    agregarMemoria(sizeof(int) * 3 * cantidad);
+
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        Fecha entrada(reservaciones[i].getFechaEntrada());
+        segmentoDeReservacion[i] = segmentoDe(entrada);
+        diasEntrada[i] = entrada.aDiasDesdeFechaBase();
+        orden[i] = i;
+    }
+    stable_sort(orden, orden + cantidad, [segmentoDeReservacion, diasEntrada](int a, int b) {
+        if (segmentoDeReservacion[a] != segmentoDeReservacion[b]) {
+            return segmentoDeReservacion[a] < segmentoDeReservacion[b];
+        }
+        return diasEntrada[a] < diasEntrada[b];
+    });
+
+    // 2. Catalogo actual, con espacio para un segmento nuevo por reservacion en el peor caso
+    int capacidadCatalogo = contarSegmentos() + cantidad;
+    int* segmentos = new int[capacidadCatalogo];
+    int* cantidades = new int[capacidadCatalogo];
+    agregarMemoria(sizeof(int) * 2 * capacidadCatalogo);
+    int numSegmentos = cargarCatalogo(segmentos, cantidades, capacidadCatalogo - cantidad);
+
+    // Un historico anterior al indice por huesped se indexa completo una sola vez
+    if (numSegmentos > 0 && !ifstream(nombreIndiceHuespedes()).is_open()) {
+        int numGuardadas = 0;
+        Reservacion* guardadas = consultar("", "", INT_MIN, INT_MAX, numGuardadas);
+        int* segmentosGuardadas = new int[numGuardadas > 0 ? numGuardadas : 1];
+        agregarMemoria(sizeof(int) * numGuardadas);
+        for (int i = 0; i < numGuardadas; ++i) {
+            incrementarIteracion();
+            segmentosGuardadas[i] = segmentoDe(Fecha(guardadas[i].getFechaEntrada()));
+        }
+        actualizarIndiceHuespedes(guardadas, segmentosGuardadas, numGuardadas);
+
+        delete[] segmentosGuardadas;
+        agregarMemoria(-static_cast<long long>(sizeof(int) * numGuardadas));
+        delete[] guardadas;
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * numGuardadas));
+    }
+
+    // 3. Cada grupo de reservaciones del mismo mes va a su segmento
+    bool exito = true;
+    for (int inicio = 0; inicio < cantidad && exito; ) {
+        int segmento = segmentoDeReservacion[orden[inicio]];
+        int fin = inicio;
+        while (fin < cantidad && segmentoDeReservacion[orden[fin]] == segmento) {
+            incrementarIteracion();
+            fin++;
+        }
+
+        exito = columnar
+            ? agregarASegmentoColumnar(segmento, reservaciones, orden + inicio, diasEntrada, fin - inicio)
+            : agregarASegmento(segmento, reservaciones, orden + inicio, diasEntrada, fin - inicio, fechaCorte);
+        if (exito) {
+            // Ubicar (o insertar en orden) el segmento en el catalogo
+            int pos = static_cast<int>(lower_bound(segmentos, segmentos + numSegmentos, segmento) - segmentos);
+            if (pos == numSegmentos || segmentos[pos] != segmento) {
+                for (int j = numSegmentos; j > pos; --j) {
+                    incrementarIteracion();
+                    segmentos[j] = segmentos[j - 1];
+                    cantidades[j] = cantidades[j - 1];
+                }
+                segmentos[pos] = segmento;
+                cantidades[pos] = 0;
+                numSegmentos++;
+            }
+            cantidades[pos] += fin - inicio;
+        }
+        inicio = fin;
+    }
+
+    // El catalogo refleja los segmentos que si se escribieron
+    exito = guardarCatalogo(segmentos, cantidades, numSegmentos) && exito;
+    exito = actualizarIndiceHuespedes(reservaciones, segmentoDeReservacion, cantidad) && exito;
+
+    delete[] segmentos;
+    delete[] cantidades;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * capacidadCatalogo));
+
+    delete[] segmentoDeReservacion;
+    delete[] diasEntrada;
+    delete[] orden;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 3 * cantidad));
+    return exito;
+}
+
+/**
+ * @brief Busca en un segmento las reservaciones que cumplen los filtros y las agrega al resultado.
+ *
+ * Con el índice del segmento se eligen los bloques candidatos (los que contienen al huésped
+ * y al alojamiento pedidos y cuyo rango de entradas se cruza con el pedido); solo esos
+ * bloques se leen del archivo de datos, saltando directamente a su posición. Si ningún
+ * bloque es candidato el archivo de datos no se abre.
+ *
+ * @param segmento Número del segmento.
+ * @param documentoHuesped Documento del huésped, o vacío para no filtrar.
+ * @param codigoAlojamiento Código del alojamiento, o vacío para no filtrar.
+ * @param diaDesde Primer día de entrada aceptado.
+ * @param diaHasta Último día de entrada aceptado.
+ * @param resultado [in/out] Arreglo de resultados (crece al doble cuando se llena).
+ * @param cantidad [in/out] Cantidad de reservaciones en `resultado`.
+ * @param capacidad [in/out] Capacidad de `resultado`.
+ */
+void ArchivoHistorico::consultarSegmento(int segmento, const string& documentoHuesped,
+                                         const string& codigoAlojamiento, int diaDesde, int diaHasta,
+                                         Reservacion*& resultado, int& cantidad, int& capacidad) const {
+    ifstream indice(nombreSegmento(segmento, ".idx"));
+    if (!indice.is_open()) return;
+
+    // 1. Bloques del segmento y listas de las claves pedidas
+    const string claveHuesped = "H|" + documentoHuesped + "|";
+    const string claveAlojamiento = "A|" + codigoAlojamiento + "|";
+    string listaHuesped, listaAlojamiento;
+    int numBloques = 0;
+    string linea;
+
+    while (getline(indice, linea)) {
+        incrementarIteracion();
+        if (linea.empty()) continue;
+        if (linea[0] == 'B') {
+            numBloques++;
+        } else if (!documentoHuesped.empty() && linea.compare(0, claveHuesped.size(), claveHuesped) == 0) {
+            listaHuesped = linea.substr(claveHuesped.size());
+        } else if (!codigoAlojamiento.empty() && linea.compare(0, claveAlojamiento.size(), claveAlojamiento) == 0) {
+            listaAlojamiento = linea.substr(claveAlojamiento.size());
+        }
+    }
+    if ((!documentoHuesped.empty() && listaHuesped.empty()) ||
+        (!codigoAlojamiento.empty() && listaAlojamiento.empty()) || numBloques == 0) {
+        return;
+    }
+
+    long long* posiciones = new long long[numBloques];
+    int* lineas = new int[numBloques];
+    int* votos = new int[numBloques];
+    agregarMemoria((sizeof(long long) + sizeof(int) * 2) * numBloques);
+
+    int requeridos = (documentoHuesped.empty() ? 0 : 1) + (codigoAlojamiento.empty() ? 0 : 1);
+    int b = 0;
+    indice.clear();
+    indice.seekg(0);
+    while (b < numBloques && getline(indice, linea)) {
+        incrementarIteracion();
+        if (linea.empty() || linea[0] != 'B') continue;
+
+        istringstream ss(linea);
+        char tipo, separador;
+        int diaMin = 0, diaMax = -1;
+        ss >> tipo >> separador >> posiciones[b] >> separador >> lineas[b]
+           >> separador >> diaMin >> separador >> diaMax;
+
+        // Un bloque fuera del rango de fechas queda descartado desde el inicio
+        votos[b] = (diaMax < diaDesde || diaMin > diaHasta) ? -1 : 0;
+        b++;
+    }
+    numBloques = b;
+
+    // 2. Bloques que contienen a todas las claves pedidas
+    const string* listasPedidas[2] = {&listaHuesped, &listaAlojamiento};
+    for (int l = 0; l < 2; ++l) {
+        const string& lista = *listasPedidas[l];
+        size_t inicio = 0;
+        while (inicio < lista.size()) {
+            incrementarIteracion();
+            size_t coma = lista.find(',', inicio);
+            if (coma == string::npos) coma = lista.size();
+            int bloque = stoi(lista.substr(inicio, coma - inicio));
+            if (bloque >= 0 && bloque < numBloques && votos[bloque] >= 0) {
+                votos[bloque]++;
+            }
+            inicio = coma + 1;
+        }
+    }
+
+    // 3. Leer solo los bloques candidatos y filtrar cada linea
+    ifstream datos(nombreSegmento(segmento, ".txt"), ios::binary);
+    for (int k = 0; k < numBloques && datos.is_open(); ++k) {
+        incrementarIteracion();
+        if (votos[k] != requeridos) continue;
+
+        datos.clear();
+        datos.seekg(posiciones[k]);
+        for (int j = 0; j < lineas[k] && getline(datos, linea); ++j) {
+            incrementarIteracion();
+            if (linea.empty() || linea[0] == '#') continue;
+
+            Reservacion reservacion = GestionArchivos::interpretarLineaReservacion(linea);
+            int dia = Fecha(reservacion.getFechaEntrada()).aDiasDesdeFechaBase();
+            if ((!documentoHuesped.empty() && reservacion.getDocumento() != documentoHuesped) ||
+                (!codigoAlojamiento.empty() && reservacion.getCodigoAlojamiento() != codigoAlojamiento) ||
+                dia < diaDesde || dia > diaHasta) {
+                continue;
+            }
+
+            agregarResultado(resultado, cantidad, capacidad, reservacion);
+        }
+    }
+
+    delete[] posiciones;
+    delete[] lineas;
+    delete[] votos;
+    agregarMemoria(-static_cast<long long>((sizeof(long long) + sizeof(int) * 2) * numBloques));
+}
+
+/**
+ * @brief Busca en los grupos columnares de un segmento y agrega los que cumplen los filtros.
+ *
+ * Un grupo se descarta por su rango de días de entrada o, leyendo solo el diccionario de la
+ * columna filtrada, si ninguna de sus filas tiene al huésped o al alojamiento pedidos. El resto
+ * de columnas solo se lee de los grupos que pueden tener resultados.
+ *
+ * @param segmento Número del segmento.
+ * @param documentoHuesped Documento del huésped, o vacío para no filtrar.
+ * @param codigoAlojamiento Código del alojamiento, o vacío para no filtrar.
+ * @param diaDesde Primer día de entrada aceptado.
+ * @param diaHasta Último día de entrada aceptado.
+ * @param resultado [in/out] Arreglo de resultados (crece al doble cuando se llena).
+ * @param cantidad [in/out] Cantidad de reservaciones en `resultado`.
+ * @param capacidad [in/out] Capacidad de `resultado`.
+ */
+void ArchivoHistorico::consultarSegmentoColumnar(int segmento, const string& documentoHuesped,
+                                                 const string& codigoAlojamiento, int diaDesde, int diaHasta,
+                                                 Reservacion*& resultado, int& cantidad, int& capacidad) const {
+    ifstream datos(nombreSegmento(segmento, ".col"), ios::binary);
+    if (!datos.is_open()) return;
+
+    int filas, diaMin, diaMax;
+    int longitudes[NUM_COLUMNAS];
+    string columnas[NUM_COLUMNAS];
+
+    while (leerCabeceraGrupo(datos, filas, diaMin, diaMax, longitudes)) {
+        incrementarIteracion();
+        long long inicioDatos = datos.tellg();
+        long long siguienteGrupo = inicioDatos;
+        for (int c = 0; c < NUM_COLUMNAS; ++c) {
+            siguienteGrupo += longitudes[c];
+        }
+
+        bool candidato = diaMax >= diaDesde && diaMin <= diaHasta;
+        int documentoBuscado = -1;
+        int alojamientoBuscado = -1;
+        if (candidato && !documentoHuesped.empty()) {
+            candidato = leerColumna(datos, inicioDatos, longitudes, COLUMNA_DOCUMENTO, columnas[COLUMNA_DOCUMENTO]);
+            documentoBuscado = candidato ? buscarEnDiccionario(columnas[COLUMNA_DOCUMENTO], documentoHuesped) : -1;
+            candidato = documentoBuscado >= 0;
+        }
+        if (candidato && !codigoAlojamiento.empty()) {
+            candidato = leerColumna(datos, inicioDatos, longitudes, COLUMNA_ALOJAMIENTO, columnas[COLUMNA_ALOJAMIENTO]);
+            alojamientoBuscado = candidato ? buscarEnDiccionario(columnas[COLUMNA_ALOJAMIENTO], codigoAlojamiento) : -1;
+            candidato = alojamientoBuscado >= 0;
+        }
+
+        if (candidato) {
+            for (int c = 0; c < NUM_COLUMNAS && candidato; ++c) {
+                candidato = leerColumna(datos, inicioDatos, longitudes, c, columnas[c]);
+            }
+        }
+        if (candidato && filas > 0 && static_cast<int>(columnas[COLUMNA_MONTO].size()) >= filas * 8
+            && static_cast<int>(columnas[COLUMNA_METODO].size()) >= filas) {
+
+            int* dias = new int[filas];
+            int* alojamientos = new int[filas];
+            int* documentos = new int[filas];
+            agregarMemoria(sizeof(int) * 3 * filas);
+
+            decodificarEntradas(columnas[COLUMNA_ENTRADA], filas, diaMin, dias);
+            int numAlojamientos = 0, numDocumentos = 0;
+            string* diccionarioAlojamientos =
+                decodificarDiccionario(columnas[COLUMNA_ALOJAMIENTO], filas, numAlojamientos, alojamientos);
+            string* diccionarioDocumentos =
+                decodificarDiccionario(columnas[COLUMNA_DOCUMENTO], filas, numDocumentos, documentos);
+
+            size_t posDuracion = 0, posPago = 0, posCodigo = 0, posAnotacion = 0, posTextoEntrada = 0;
+            for (int i = 0; i < filas; ++i) {
+                incrementarIteracion();
+                int duracion = static_cast<int>(leerVarint(columnas[COLUMNA_DURACION], posDuracion));
+                unsigned long long pago = leerVarint(columnas[COLUMNA_PAGO], posPago);
+                string fechaPago = (pago == 0) ? leerTexto(columnas[COLUMNA_PAGO], posPago) : "";
+                string codigo = leerTexto(columnas[COLUMNA_CODIGO], posCodigo);
+                string anotacion = leerTexto(columnas[COLUMNA_ANOTACION], posAnotacion);
+                string fechaEntrada = leerTexto(columnas[COLUMNA_TEXTO_ENTRADA], posTextoEntrada);
+
+                if (dias[i] < diaDesde || dias[i] > diaHasta ||
+                    (documentoBuscado >= 0 && documentos[i] != documentoBuscado) ||
+                    (alojamientoBuscado >= 0 && alojamientos[i] != alojamientoBuscado)) {
+                    continue;
+                }
+
+                if (pago != 0) {
+                    unsigned long long zigzag = pago - 1;
+                    long long diferencia = static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1);
+                    fechaPago = Fecha::desdeDiasFechaBase(dias[i] + static_cast<int>(diferencia)).toString();
+                }
+                if (fechaEntrada.empty()) {
+                    fechaEntrada = Fecha::desdeDiasFechaBase(dias[i]).toString();
+                }
+                long long monto = static_cast<long long>(leerFijo(columnas[COLUMNA_MONTO].data() + i * 8, 8));
+
+                agregarResultado(resultado, cantidad, capacidad,
+                                 Reservacion(codigo, fechaEntrada, duracion,
+                                             diccionarioAlojamientos[alojamientos[i]],
+                                             diccionarioDocumentos[documentos[i]], columnas[COLUMNA_METODO][i],
+                                             fechaPago, static_cast<float>(monto), anotacion));
+            }
+
+            delete[] diccionarioAlojamientos;
+            delete[] diccionarioDocumentos;
+            agregarMemoria(-static_cast<long long>(sizeof(string) * (numAlojamientos + numDocumentos)));
+            delete[] dias;
+            delete[] alojamientos;
+            delete[] documentos;
+            agregarMemoria(-static_cast<long long>(sizeof(int) * 3 * filas));
+        }
+
+        datos.clear();
+        datos.seekg(siguienteGrupo);
+    }
+}
+
+/**
+ * @brief Consulta el histórico leyendo solo los segmentos y bloques que pueden tener resultados.
+ *
+ * Con un rango de fechas solo se consideran los segmentos de los meses del rango; sin él,
+ * todos los del catálogo, o solo los que el índice por huésped asocia al documento pedido.
+ * De cada segmento visitado se lee el índice y únicamente los bloques candidatos, y de sus
+ * grupos columnares solo los que tienen al huésped o al alojamiento pedidos.
+ *
+ * @param documentoHuesped Documento del huésped, o vacío para no filtrar.
+ * @param codigoAlojamiento Código del alojamiento, o vacío para no filtrar.
+ * @param diaDesde Primer día de entrada aceptado (INT_MIN para no limitar).
+ * @param diaHasta Último día de entrada aceptado (INT_MAX para no limitar).
+ * @param cantidad [out] Cantidad de reservaciones encontradas.
+ * @return Arreglo con las reservaciones, por mes y fecha de entrada, o nullptr si no hay ninguna.
+ */
+Reservacion* ArchivoHistorico::consultar(const string& documentoHuesped, const string& codigoAlojamiento,
+                                         int diaDesde, int diaHasta, int& cantidad) const {
+    cantidad = 0;
+    int capacidadCatalogo = contarSegmentos();
+    if (capacidadCatalogo == 0 || diaHasta < diaDesde) return nullptr;
+
+    int* segmentos = new int[capacidadCatalogo];
+    int* cantidades = new int[capacidadCatalogo];
+    agregarMemoria(sizeof(int) * 2 * capacidadCatalogo);
+    int numSegmentos = cargarCatalogo(segmentos, cantidades, capacidadCatalogo);
+
+    int primerSegmento = (diaDesde == INT_MIN) ? INT_MIN : segmentoDe(Fecha::desdeDiasFechaBase(diaDesde));
+    int ultimoSegmento = (diaHasta == INT_MAX) ? INT_MAX : segmentoDe(Fecha::desdeDiasFechaBase(diaHasta));
+
+    // Con el indice por huesped solo se visitan los segmentos donde aparece el documento
+    string segmentosHuesped;
+    bool filtrarSegmentos = !documentoHuesped.empty() && segmentosDeHuesped(documentoHuesped, segmentosHuesped);
+    segmentosHuesped = "," + segmentosHuesped + ",";
+
+    Reservacion* resultado = nullptr;
+    int capacidad = 0;
+    for (int i = 0; i < numSegmentos; ++i) {
+        incrementarIteracion();
+        if (cantidades[i] == 0 || segmentos[i] < primerSegmento || segmentos[i] > ultimoSegmento) continue;
+        if (filtrarSegmentos && segmentosHuesped.find("," + textoSegmento(segmentos[i]) + ",") == string::npos) continue;
+        consultarSegmento(segmentos[i], documentoHuesped, codigoAlojamiento, diaDesde, diaHasta,
+                          resultado, cantidad, capacidad);
+        consultarSegmentoColumnar(segmentos[i], documentoHuesped, codigoAlojamiento, diaDesde, diaHasta,
+                                  resultado, cantidad, capacidad);
+    }
+
+    delete[] segmentos;
+    delete[] cantidades;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * capacidadCatalogo));
+
+    // El llamador libera cantidad elementos: se ajusta el arreglo a su tamano exacto
+    if (cantidad < capacidad) {
+        Reservacion* exacto = nullptr;
+        if (cantidad > 0) {
+            exacto = new Reservacion[cantidad];
+            agregarMemoria(sizeof(Reservacion) * cantidad);
+            for (int i = 0; i < cantidad; ++i) {
+                incrementarIteracion();
+                exacto[i] = resultado[i];
+            }
+        }
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * capacidad));
+        delete[] resultado;
+        resultado = exacto;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Reservaciones históricas de un huésped.
+ *
+ * @param documentoHuesped Documento del huésped.
+ * @param cantidad [out] Cantidad de reservaciones encontradas.
+ * @return Arreglo con las reservaciones, o nullptr si no hay ninguna.
+ *
+ * @note El arreglo retornado debe ser liberado por el llamador con delete[].
+ */
+Reservacion* ArchivoHistorico::consultarPorHuesped(const string& documentoHuesped, int& cantidad) const {
+    return consultar(documentoHuesped, "", INT_MIN, INT_MAX, cantidad);
+}
+
+/**
+ * @brief Reservaciones históricas de un alojamiento.
+ *
+ * @param codigoAlojamiento Código del alojamiento.
+ * @param cantidad [out] Cantidad de reservaciones encontradas.
+ * @return Arreglo con las reservaciones, o nullptr si no hay ninguna.
+ *
+ * @note El arreglo retornado debe ser liberado por el llamador con delete[].
+ */
+Reservacion* ArchivoHistorico::consultarPorAlojamiento(const string& codigoAlojamiento, int& cantidad) const {
+    return consultar("", codigoAlojamiento, INT_MIN, INT_MAX, cantidad);
+}
+
+/**
+ * @brief Reservaciones históricas con fecha de entrada dentro de un rango.
+ *
+ * @param desde Primera fecha de entrada.
+ * @param hasta Última fecha de entrada (inclusive).
+ * @param cantidad [out] Cantidad de reservaciones encontradas.
+ * @return Arreglo con las reservaciones, o nullptr si no hay ninguna.
+ *
+ * @note El arreglo retornado debe ser liberado por el llamador con delete[].
+ */
+Reservacion* ArchivoHistorico::consultarPorFechas(const Fecha& desde, const Fecha& hasta, int& cantidad) const {
+    return consultar("", "", desde.aDiasDesdeFechaBase(), hasta.aDiasDesdeFechaBase(), cantidad);
+}
+
+/**
+ * @brief Lee los campos numéricos de los grupos columnares de un segmento.
+ *
+ * De cada grupo se lee primero el diccionario de alojamientos, y cada código distinto se
+ * busca una sola vez en el índice del llamador. Si el grupo no tiene alojamientos conocidos
+ * (y solo se piden esos) o su rango de entradas no se cruza con el pedido, se salta sin leer
+ * nada más. De los demás se leen solo entradas, noches, montos, métodos y fechas de pago:
+ * documentos, códigos y anotaciones no se tocan.
+ *
+ * @param segmento Número del segmento.
+ * @param diaDesde Primer día de entrada aceptado.
+ * @param diaHasta Último día de entrada aceptado.
+ * @param indiceAlojamientos Código de alojamiento -> valor que se guarda en cada fila.
+ * @param soloConocidos true para omitir las filas cuyo alojamiento no está en el índice.
+ * @param resultado [in/out] Arreglo de filas (crece al doble cuando se llena).
+ * @param cantidad [in/out] Cantidad de filas en `resultado`.
+ * @param capacidad [in/out] Capacidad de `resultado`.
+ */
+void ArchivoHistorico::leerFilasSegmentoColumnar(int segmento, int diaDesde, int diaHasta,
+                                                 const IndiceHash& indiceAlojamientos, bool soloConocidos,
+                                                 FilaHistorica*& resultado, int& cantidad, int& capacidad) const {
+    ifstream datos(nombreSegmento(segmento, ".col"), ios::binary);
+    if (!datos.is_open()) return;
+
+    int filas, diaMin, diaMax;
+    int longitudes[NUM_COLUMNAS];
+    string columnas[NUM_COLUMNAS];
+
+    while (leerCabeceraGrupo(datos, filas, diaMin, diaMax, longitudes)) {
+        incrementarIteracion();
+        long long inicioDatos = datos.tellg();
+        long long siguienteGrupo = inicioDatos;
+        for (int c = 0; c < NUM_COLUMNAS; ++c) {
+            siguienteGrupo += longitudes[c];
+        }
+
+        if (filas > 0 && diaMax >= diaDesde && diaMin <= diaHasta &&
+            leerColumna(datos, inicioDatos, longitudes, COLUMNA_ALOJAMIENTO, columnas[COLUMNA_ALOJAMIENTO])) {
+
+            int* alojamientoDeFila = new int[filas];
+            agregarMemoria(sizeof(int) * filas);
+            int numCodigos = 0;
+            string* diccionario = decodificarDiccionario(columnas[COLUMNA_ALOJAMIENTO], filas, numCodigos,
+                                                         alojamientoDeFila);
+
+            // Cada codigo distinto del grupo se resuelve una vez
+            int* valorDeCodigo = new int[numCodigos > 0 ? numCodigos : 1];
+            agregarMemoria(sizeof(int) * numCodigos);
+            bool hayConocidos = false;
+            for (int v = 0; v < numCodigos; ++v) {
+                incrementarIteracion();
+                valorDeCodigo[v] = indiceAlojamientos.buscar(diccionario[v]);
+                hayConocidos = hayConocidos || valorDeCodigo[v] >= 0;
+            }
+            delete[] diccionario;
+            agregarMemoria(-static_cast<long long>(sizeof(string) * numCodigos));
+
+            bool candidato = (hayConocidos || !soloConocidos) &&
+                leerColumna(datos, inicioDatos, longitudes, COLUMNA_ENTRADA, columnas[COLUMNA_ENTRADA]) &&
+                leerColumna(datos, inicioDatos, longitudes, COLUMNA_DURACION, columnas[COLUMNA_DURACION]) &&
+                leerColumna(datos, inicioDatos, longitudes, COLUMNA_MONTO, columnas[COLUMNA_MONTO]) &&
+                leerColumna(datos, inicioDatos, longitudes, COLUMNA_METODO, columnas[COLUMNA_METODO]) &&
+                leerColumna(datos, inicioDatos, longitudes, COLUMNA_PAGO, columnas[COLUMNA_PAGO]);
+            if (candidato && static_cast<int>(columnas[COLUMNA_MONTO].size()) >= filas * 8 &&
+                static_cast<int>(columnas[COLUMNA_METODO].size()) >= filas) {
+
+                int* dias = new int[filas];
+                agregarMemoria(sizeof(int) * filas);
+                decodificarEntradas(columnas[COLUMNA_ENTRADA], filas, diaMin, dias);
+
+                size_t posDuracion = 0, posPago = 0;
+                for (int i = 0; i < filas; ++i) {
+                    incrementarIteracion();
+                    int duracion = static_cast<int>(leerVarint(columnas[COLUMNA_DURACION], posDuracion));
+                    unsigned long long pago = leerVarint(columnas[COLUMNA_PAGO], posPago);
+                    string fechaPago = (pago == 0) ? leerTexto(columnas[COLUMNA_PAGO], posPago) : "";
+
+                    int alojamiento = valorDeCodigo[alojamientoDeFila[i]];
+                    if (dias[i] < diaDesde || dias[i] > diaHasta || (soloConocidos && alojamiento < 0)) {
+                        continue;
+                    }
+
+                    FilaHistorica fila;
+                    fila.diaEntrada = dias[i];
+                    fila.noches = duracion;
+                    fila.monto = static_cast<long long>(leerFijo(columnas[COLUMNA_MONTO].data() + i * 8, 8));
+                    fila.alojamiento = alojamiento;
+                    fila.metodoPago = columnas[COLUMNA_METODO][i];
+                    if (pago != 0) {
+                        unsigned long long zigzag = pago - 1;
+                        long long diferencia = static_cast<long long>(zigzag >> 1) ^ -static_cast<long long>(zigzag & 1);
+                        fila.diaPago = dias[i] + static_cast<int>(diferencia);
+                    } else {
+                        Fecha fecha(fechaPago);
+                        fila.diaPago = fecha.esValida() ? fecha.aDiasDesdeFechaBase() : FilaHistorica::SIN_FECHA_PAGO;
+                    }
+                    agregarFila(resultado, cantidad, capacidad, fila);
+                }
+
+                delete[] dias;
+                agregarMemoria(-static_cast<long long>(sizeof(int) * filas));
+            }
+
+            delete[] valorDeCodigo;
+            agregarMemoria(-static_cast<long long>(sizeof(int) * numCodigos));
+            delete[] alojamientoDeFila;
+            agregarMemoria(-static_cast<long long>(sizeof(int) * filas));
+        }
+
+        datos.clear();
+        datos.seekg(siguienteGrupo);
+    }
+}
+
+/**
+ * @brief Campos numéricos de las reservaciones históricas con entrada dentro de un rango.
+ *
+ * Es la lectura de los reportes: de los grupos columnares solo se leen las columnas enteras
+ * (ver `leerFilasSegmentoColumnar`) y el alojamiento llega ya traducido con el índice del
+ * llamador, sin armar objetos `Reservacion` ni interpretar fechas en texto. Los cortes
+ * guardados en texto se leen completos y se convierten fila por fila.
+ *
+ * @param diaDesde Primer día de entrada aceptado (INT_MIN para no limitar).
+ * @param diaHasta Último día de entrada aceptado (INT_MAX para no limitar).
+ * @param indiceAlojamientos Código de alojamiento -> valor que se guarda en `FilaHistorica::alojamiento`
+ *                           (-1 si el código no está).
+ * @param soloConocidos true para omitir las filas cuyo alojamiento no está en el índice.
+ * @param cantidad [out] Cantidad de filas.
+ * @return Arreglo con las filas, por mes de entrada, o nullptr si no hay ninguna.
+ *
+ * @note El arreglo retornado debe ser liberado por el llamador con delete[].
+ */
+FilaHistorica* ArchivoHistorico::leerFilas(int diaDesde, int diaHasta, const IndiceHash& indiceAlojamientos,
+                                           bool soloConocidos, int& cantidad) const {
+    cantidad = 0;
+    int capacidadCatalogo = contarSegmentos();
+    if (capacidadCatalogo == 0 || diaHasta < diaDesde) return nullptr;
+
+    int* segmentos = new int[capacidadCatalogo];
+    int* cantidades = new int[capacidadCatalogo];
+    agregarMemoria(sizeof(int) * 2 * capacidadCatalogo);
+    int numSegmentos = cargarCatalogo(segmentos, cantidades, capacidadCatalogo);
+
+    int primerSegmento = (diaDesde == INT_MIN) ? INT_MIN : segmentoDe(Fecha::desdeDiasFechaBase(diaDesde));
+    int ultimoSegmento = (diaHasta == INT_MAX) ? INT_MAX : segmentoDe(Fecha::desdeDiasFechaBase(diaHasta));
+
+    FilaHistorica* resultado = nullptr;
+    int capacidad = 0;
+    for (int s = 0; s < numSegmentos; ++s) {
+        incrementarIteracion();
+        if (cantidades[s] == 0 || segmentos[s] < primerSegmento || segmentos[s] > ultimoSegmento) continue;
+
+        // 1. Cortes guardados en texto
+        Reservacion* filasTexto = nullptr;
+        int numFilasTexto = 0, capacidadTexto = 0;
+        consultarSegmento(segmentos[s], "", "", diaDesde, diaHasta, filasTexto, numFilasTexto, capacidadTexto);
+        for (int i = 0; i < numFilasTexto; ++i) {
+            incrementarIteracion();
+            const Reservacion& reservacion = filasTexto[i];
+            int alojamiento = indiceAlojamientos.buscar(reservacion.getCodigoAlojamiento());
+            if (soloConocidos && alojamiento < 0) continue;
+
+            Fecha pago(reservacion.getFechaPago());
+            FilaHistorica fila;
+            fila.diaEntrada = Fecha(reservacion.getFechaEntrada()).aDiasDesdeFechaBase();
+            fila.noches = reservacion.getDuracion();
+            fila.monto = llround(reservacion.getMonto());
+            fila.alojamiento = alojamiento;
+            fila.metodoPago = reservacion.getMetodoPago();
+            fila.diaPago = pago.esValida() ? pago.aDiasDesdeFechaBase() : FilaHistorica::SIN_FECHA_PAGO;
+            agregarFila(resultado, cantidad, capacidad, fila);
+        }
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * capacidadTexto));
+        delete[] filasTexto;
+
+        // 2. Grupos columnares: solo las columnas enteras
+        leerFilasSegmentoColumnar(segmentos[s], diaDesde, diaHasta, indiceAlojamientos, soloConocidos,
+                                  resultado, cantidad, capacidad);
+    }
+
+    delete[] segmentos;
+    delete[] cantidades;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * capacidadCatalogo));
+
+    // El llamador libera cantidad elementos: se ajusta el arreglo a su tamano exacto
+    if (cantidad < capacidad) {
+        FilaHistorica* exacto = nullptr;
+        if (cantidad > 0) {
+            exacto = new FilaHistorica[cantidad];
+            agregarMemoria(sizeof(FilaHistorica) * cantidad);
+            for (int i = 0; i < cantidad; ++i) {
+                incrementarIteracion();
+                exacto[i] = resultado[i];
+            }
+        }
+        agregarMemoria(-static_cast<long long>(sizeof(FilaHistorica) * capacidad));
+        delete[] resultado;
+        resultado = exacto;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Borra los archivos de unos segmentos, el catálogo y el índice por huésped.
+ *
+ * Se usa con el histórico temporal de una importación, para descartar lo que dejó un
+ * intento que no terminó.
+ *
+ * @param segmentos Números de segmento.
+ * @param numSegmentos Cantidad de segmentos.
+ */
+void ArchivoHistorico::eliminarArchivos(const int* segmentos, int numSegmentos) const {
+    const string extensiones[3] = {".txt", ".idx", ".col"};
+    for (int i = 0; i < numSegmentos; ++i) {
+        for (int e = 0; e < 3; ++e) {
+            incrementarIteracion();
+            remove(nombreSegmento(segmentos[i], extensiones[e]).c_str());
+        }
+    }
+    remove(nombreIndiceHuespedes().c_str());
+    remove((prefijo + ".idx").c_str());
+}
+
+/**
+ * @brief Renombra los archivos de unos segmentos, el índice por huésped y el catálogo a otro prefijo.
+ *
+ * El catálogo se renombra al final: mientras no esté, las consultas del destino no ven los
+ * segmentos ya renombrados, y repetir la operación los reemplaza en lugar de duplicarlos.
+ *
+ * @param destino Prefijo de los archivos de destino.
+ * @param segmentos Números de segmento.
+ * @param numSegmentos Cantidad de segmentos.
+ * @return true si se renombraron todos los archivos existentes.
+ */
+bool ArchivoHistorico::renombrarArchivos(const string& destino, const int* segmentos, int numSegmentos) const {
+    ArchivoHistorico historicoDestino(destino);
+    const string extensiones[3] = {".txt", ".idx", ".col"};
+    const int totalNombres = numSegmentos * 3 + 2;
+
+    bool exito = true;
+    for (int k = 0; k < totalNombres && exito; ++k) {
+        incrementarIteracion();
+        string origen, nuevo;
+        if (k < numSegmentos * 3) {
+            origen = nombreSegmento(segmentos[k / 3], extensiones[k % 3]);
+            nuevo = historicoDestino.nombreSegmento(segmentos[k / 3], extensiones[k % 3]);
+        } else if (k == numSegmentos * 3) {
+            origen = nombreIndiceHuespedes();
+            nuevo = historicoDestino.nombreIndiceHuespedes();
+        } else {
+            origen = prefijo + ".idx";
+            nuevo = destino + ".idx";
+        }
+        if (!ifstream(origen).is_open()) continue;
+
+        remove(nuevo.c_str());
+        exito = rename(origen.c_str(), nuevo.c_str()) == 0;
+    }
+    return exito;
+}
+
+/**
+ * @brief Importa el histórico de un solo archivo (formato anterior) a los segmentos.
+ *
+ * Lee `prefijo + ".txt"`, ignora las líneas de comentario de cada lote y guarda todas las
+ * reservaciones en segmentos temporales (`prefijo + "_importacion"`). Solo si todos se
+ * escribieron se renombran a los definitivos y el archivo anterior se renombra con la
+ * extensión ".migrado"; si algo falla, lo temporal se descarta y la importación se repite
+ * completa en el siguiente arranque, sin duplicar meses.
+ *
+ * Si el histórico por segmentos ya tiene datos no se importa nada: el archivo anterior
+ * podría estar ya incluido (por ejemplo, si antes falló solo su renombrado).
+ *
+ * @return Cantidad de reservaciones importadas (0 si no había archivo anterior o si falló).
+ */
+int ArchivoHistorico::importarArchivoUnico() const {
+    const string nombre = prefijo + ".txt";
+    ifstream archivo(nombre);
+    if (!archivo.is_open()) return 0;
+
+    if (contarSegmentos() > 0) {
+        cout << "Error: Ya existe un historico por segmentos; " << nombre
+             << " no se importa para no duplicar reservaciones.\n";
+        return 0;
+    }
+
+    int total = 0;
+    string linea;
+    while (getline(archivo, linea)) {
+        incrementarIteracion();
+        total += (linea.empty() || linea[0] == '#' || linea == "\r") ? 0 : 1;
+    }
+
+    Reservacion* leidas = new Reservacion[total > 0 ? total : 1];
+    int* segmentosLeidos = new int[total > 0 ? total : 1];
+    agregarMemoria((sizeof(Reservacion) + sizeof(int)) * total);
+
+    int cantidad = 0;
+    archivo.clear();
+    archivo.seekg(0);
+    while (cantidad < total && getline(archivo, linea)) {
+        incrementarIteracion();
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        if (linea.empty() || linea[0] == '#') continue;
+        leidas[cantidad] = GestionArchivos::interpretarLineaReservacion(linea);
+        segmentosLeidos[cantidad] = segmentoDe(Fecha(leidas[cantidad].getFechaEntrada()));
+        cantidad++;
+    }
+    archivo.close();
+
+    sort(segmentosLeidos, segmentosLeidos + cantidad);
+    int numSegmentos = static_cast<int>(unique(segmentosLeidos, segmentosLeidos + cantidad) - segmentosLeidos);
+
+    // Se escribe en archivos temporales, descartando los de un intento anterior que no termino
+    ArchivoHistorico temporal(prefijo + "_importacion");
+    temporal.setColumnar(columnar);
+    temporal.eliminarArchivos(segmentosLeidos, numSegmentos);
+    bool exito = temporal.guardar(leidas, cantidad, Fecha::obtenerFechaActual()) &&
+                 temporal.renombrarArchivos(prefijo, segmentosLeidos, numSegmentos);
+    if (!exito) {
+        temporal.eliminarArchivos(segmentosLeidos, numSegmentos);
+        cout << "Error: No se pudo importar " << nombre << " al historico por segmentos.\n";
+    } else if (rename(nombre.c_str(), (nombre + ".migrado").c_str()) != 0) {
+        // Los segmentos ya tienen las reservaciones; el siguiente arranque no las importa otra vez
+        cout << "Error: No se pudo renombrar " << nombre << " a " << nombre << ".migrado.\n";
+    }
+
+    delete[] leidas;
+    delete[] segmentosLeidos;
+    agregarMemoria(-static_cast<long long>((sizeof(Reservacion) + sizeof(int)) * total));
+    return exito ? cantidad : 0;
+}
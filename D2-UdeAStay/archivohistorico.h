@@ -0,0 +1,94 @@
+#ifndef ARCHIVOHISTORICO_H
+#define ARCHIVOHISTORICO_H
+
+#include <climits>
+#include <string>
+
+class Reservacion;
+class Fecha;
+class IndiceHash;
+
+using namespace std;
+
+// Campos numericos de una reservacion historica, leidos sin armar el objeto Reservacion
+struct FilaHistorica {
+    static const int SIN_FECHA_PAGO = INT_MIN;
+
+    int diaEntrada;     // Dias desde la fecha base
+    int noches;
+    long long monto;
+    int alojamiento;    // Valor del codigo en el indice del llamador (-1 si no esta)
+    int diaPago;        // Dias desde la fecha base, o SIN_FECHA_PAGO si la fecha no es valida
+    char metodoPago;
+};
+
+// Historico de reservaciones particionado en un segmento por mes de entrada.
+// Cada segmento tiene un indice disperso por bloques de lineas: rango de fechas de entrada
+// de cada bloque y bloques donde aparece cada huesped y cada alojamiento.
+// Un indice general por huesped lista los segmentos donde aparece cada documento.
+// En formato columnar cada corte agrega al segmento un grupo binario (".col") con una
+// columna por campo, para que los reportes lean solo las columnas que necesitan.
+// Los enteros de ancho fijo de esos grupos (cabecera y montos) van en little-endian.
+class ArchivoHistorico {
+private:
+
+    string prefijo;     // Nombre base de los archivos ("HistoricoReservaciones")
+    bool columnar;      // Formato en que se escriben los cortes nuevos
+
+    string nombreSegmento(int segmento, const string& extension) const;
+    string nombreIndiceHuespedes() const;
+    bool actualizarIndiceHuespedes(const Reservacion* reservaciones, const int* segmentoDeReservacion,
+                                   int cantidad) const;
+    bool segmentosDeHuesped(const string& documentoHuesped, string& lista) const;
+    int contarSegmentos() const;
+    int cargarCatalogo(int* segmentos, int* cantidades, int capacidad) const;
+    bool guardarCatalogo(const int* segmentos, const int* cantidades, int numSegmentos) const;
+    void eliminarArchivos(const int* segmentos, int numSegmentos) const;
+    bool renombrarArchivos(const string& destino, const int* segmentos, int numSegmentos) const;
+    bool agregarASegmento(int segmento, const Reservacion* reservaciones, const int* orden,
+                          const int* diasEntrada, int cantidad, const string& fechaCorte) const;
+    bool agregarASegmentoColumnar(int segmento, const Reservacion* reservaciones, const int* orden,
+                                  const int* diasEntrada, int cantidad) const;
+    void consultarSegmento(int segmento, const string& documentoHuesped, const string& codigoAlojamiento,
+                           int diaDesde, int diaHasta, Reservacion*& resultado, int& cantidad,
+                           int& capacidad) const;
+    void consultarSegmentoColumnar(int segmento, const string& documentoHuesped,
+                                   const string& codigoAlojamiento, int diaDesde, int diaHasta,
+                                   Reservacion*& resultado, int& cantidad, int& capacidad) const;
+    Reservacion* consultar(const string& documentoHuesped, const string& codigoAlojamiento,
+                           int diaDesde, int diaHasta, int& cantidad) const;
+    void leerFilasSegmentoColumnar(int segmento, int diaDesde, int diaHasta, const IndiceHash& indiceAlojamientos,
+                                   bool soloConocidos, FilaHistorica*& resultado, int& cantidad,
+                                   int& capacidad) const;
+
+public:
+
+    // Lineas de cada bloque del indice disperso
+    static const int LINEAS_POR_BLOQUE = 64;
+
+    // Constructor
+    ArchivoHistorico(const string& prefijo = "HistoricoReservaciones");
+
+    // Formato de escritura (las consultas leen ambos)
+    bool esColumnar() const { return columnar; }
+    void setColumnar(bool valor) { columnar = valor; }
+
+    // Escritura
+    bool guardar(const Reservacion* reservaciones, int cantidad, const string& fechaCorte) const;
+    int importarArchivoUnico() const;
+
+    // Consultas (el arreglo retornado lo libera el llamador)
+    Reservacion* consultarPorHuesped(const string& documentoHuesped, int& cantidad) const;
+    Reservacion* consultarPorAlojamiento(const string& codigoAlojamiento, int& cantidad) const;
+    Reservacion* consultarPorFechas(const Fecha& desde, const Fecha& hasta, int& cantidad) const;
+
+    // Reportes: solo columnas numericas, con el alojamiento traducido por el indice del llamador
+    FilaHistorica* leerFilas(int diaDesde, int diaHasta, const IndiceHash& indiceAlojamientos,
+                             bool soloConocidos, int& cantidad) const;
+
+    // Segmento (anio * 12 + mes - 1) al que pertenece una fecha de entrada
+    static int segmentoDe(const Fecha& fechaEntrada);
+    static string textoSegmento(int segmento);
+};
+
+#endif // ARCHIVOHISTORICO_H
@@ -0,0 +1,261 @@
+#include "cachebusquedas.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Constructor de la clase CacheBusquedas.
+ *
+ * Reserva de una vez las posiciones de la cache; los resultados de cada entrada se
+ * reservan al guardarla.
+ *
+ * @param capacidad Cantidad máxima de consultas guardadas (mínimo 1).
+ */
+CacheBusquedas::CacheBusquedas(int capacidad) : entradas(nullptr), capacidad(max(capacidad, 1)),
+    numEntradas(0), masReciente(-1), menosReciente(-1), primeraLibre(0) {
+
+    entradas = new EntradaCacheBusqueda[this->capacidad];
+    agregarMemoria(sizeof(EntradaCacheBusqueda) * this->capacidad);
+
+    for (int i = 0; i < this->capacidad; ++i) {
+        incrementarIteracion();
+        entradas[i].resultados = nullptr;
+        entradas[i].cantidad = 0;
+        entradas[i].anterior = -1;
+        entradas[i].siguiente = (i + 1 < this->capacidad) ? i + 1 : -1;
+    }
+    indiceClaves.reservar(this->capacidad);
+}
+
+/**
+ * @brief Destructor de la clase CacheBusquedas.
+ *
+ * Libera los resultados guardados y las posiciones de la cache.
+ */
+CacheBusquedas::~CacheBusquedas() {
+    limpiar();
+    agregarMemoria(-static_cast<long long>(sizeof(EntradaCacheBusqueda) * capacidad));
+    delete[] entradas;
+}
+
+/**
+ * @brief Quita una entrada de la lista de uso.
+ *
+ * @param pos Posición de la entrada.
+ */
+void CacheBusquedas::desenlazar(int pos) {
+    EntradaCacheBusqueda& e = entradas[pos];
+    if (e.anterior >= 0) entradas[e.anterior].siguiente = e.siguiente;
+    else masReciente = e.siguiente;
+    if (e.siguiente >= 0) entradas[e.siguiente].anterior = e.anterior;
+    else menosReciente = e.anterior;
+    e.anterior = e.siguiente = -1;
+}
+
+/**
+ * @brief Pone una entrada al frente de la lista de uso (la más reciente).
+ *
+ * @param pos Posición de la entrada.
+ */
+void CacheBusquedas::enlazarAlFrente(int pos) {
+    entradas[pos].anterior = -1;
+    entradas[pos].siguiente = masReciente;
+    if (masReciente >= 0) entradas[masReciente].anterior = pos;
+    masReciente = pos;
+    if (menosReciente < 0) menosReciente = pos;
+}
+
+/**
+ * @brief Elimina una entrada de la cache y deja su posición libre.
+ *
+ * @param pos Posición de la entrada.
+ */
+void CacheBusquedas::descartar(int pos) {
+    EntradaCacheBusqueda& e = entradas[pos];
+
+    indiceClaves.eliminar(e.clave);
+    desenlazar(pos);
+
+    agregarMemoria(-static_cast<long long>(sizeof(int) * e.cantidad));
+    delete[] e.resultados;
+    e.resultados = nullptr;
+    e.cantidad = 0;
+    e.clave.clear();
+    e.municipio.clear();
+
+    e.siguiente = primeraLibre;
+    primeraLibre = pos;
+    numEntradas--;
+}
+
+/**
+ * @brief Busca una consulta en la cache y, si está, copia sus resultados.
+ *
+ * Un acierto convierte a la entrada en la más reciente.
+ *
+ * @param clave Clave de la consulta (ver `construirClave`).
+ * @param destino [out] Arreglo con espacio para todos los alojamientos del sistema.
+ * @param cantidad [out] Cantidad de índices copiados.
+ * @return true si la consulta estaba en la cache; false en caso contrario.
+ */
+bool CacheBusquedas::buscar(const string& clave, int* destino, int& cantidad) {
+    int pos = indiceClaves.buscar(clave);
+    if (pos < 0) return false;
+
+    const EntradaCacheBusqueda& e = entradas[pos];
+    for (int i = 0; i < e.cantidad; ++i) {
+        incrementarIteracion();
+        destino[i] = e.resultados[i];
+    }
+    cantidad = e.cantidad;
+
+    if (masReciente != pos) {
+        desenlazar(pos);
+        enlazarAlFrente(pos);
+    }
+    return true;
+}
+
+/**
+ * @brief Guarda los resultados de una consulta como la entrada más reciente.
+ *
+ * Si la cache está llena se descarta la entrada usada hace más tiempo.
+ *
+ * @param clave Clave de la consulta (ver `construirClave`).
+ * @param municipio Municipio consultado (se guarda normalizado para invalidar).
+ * @param diaInicio Día de entrada consultado, contado desde la fecha base.
+ * @param noches Número de noches consultadas.
+ * @param resultados Índices de alojamientos retornados por la búsqueda.
+ * @param cantidad Cantidad de índices.
+ */
+void CacheBusquedas::guardar(const string& clave, const string& municipio, int diaInicio, int noches,
+                             const int* resultados, int cantidad) {
+    int existente = indiceClaves.buscar(clave);
+    if (existente >= 0) {
+        descartar(existente);
+    }
+    if (primeraLibre < 0) {
+        descartar(menosReciente);
+    }
+
+    int pos = primeraLibre;
+    primeraLibre = entradas[pos].siguiente;
+
+    EntradaCacheBusqueda& e = entradas[pos];
+    e.clave = clave;
+    e.municipio = IndiceHash::normalizarClave(municipio);
+    e.diaInicio = diaInicio;
+    e.diaFin = diaInicio + noches;
+    e.cantidad = cantidad;
+    e.resultados = new int[cantidad];
+    agregarMemoria(sizeof(int) * cantidad);
+
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        e.resultados[i] = resultados[i];
+    }
+
+    indiceClaves.insertar(clave, pos);
+    enlazarAlFrente(pos);
+    numEntradas++;
+}
+
+/**
+ * @brief Descarta las consultas afectadas por una reservación nueva o cancelada.
+ *
+ * Solo se descartan las entradas del mismo municipio cuyas noches consultadas se cruzan
+ * con las de la reservación; el resto de la cache sigue siendo válida.
+ *
+ * @param municipio Municipio del alojamiento reservado.
+ * @param diaInicio Día de entrada de la reservación, contado desde la fecha base.
+ * @param noches Duración de la reservación.
+ * @return Cantidad de entradas descartadas.
+ */
+int CacheBusquedas::invalidar(const string& municipio, int diaInicio, int noches) {
+    string clave = IndiceHash::normalizarClave(municipio);
+    int diaFin = diaInicio + noches;
+    int descartadas = 0;
+
+    int pos = masReciente;
+    while (pos >= 0) {
+        incrementarIteracion();
+        int siguiente = entradas[pos].siguiente;
+        const EntradaCacheBusqueda& e = entradas[pos];
+
+        if (e.diaInicio < diaFin && diaInicio < e.diaFin && e.municipio == clave) {
+            descartar(pos);
+            descartadas++;
+        }
+        pos = siguiente;
+    }
+    return descartadas;
+}
+
+/**
+ * @brief Descarta todas las consultas guardadas.
+ *
+ * Se usa cuando cambia un dato que afecta a cualquier búsqueda (el conjunto de
+ * reservaciones tras el corte histórico).
+ */
+void CacheBusquedas::limpiar() {
+    while (masReciente >= 0) {
+        incrementarIteracion();
+        descartar(masReciente);
+    }
+}
+
+/**
+ * @brief Construye la clave canónica de una consulta de disponibilidad.
+ *
+ * El municipio y las amenidades se normalizan (ver `IndiceHash::normalizarClave`) y las
+ * amenidades se ordenan sin repetidos, así "WiFi, piscina" y "piscina,wifi" comparten
+ * clave. Los límites negativos (sin filtro) se representan igual sin importar su valor.
+ *
+ * @param municipio Municipio de la consulta.
+ * @param diaInicio Día de entrada, contado desde la fecha base.
+ * @param noches Número de noches.
+ * @param precioMax Precio máximo por noche (negativo si no se filtra).
+ * @param puntuacionMin Puntuación mínima del anfitrión (negativa si no se filtra).
+ * @param amenidadesRequeridas Amenidades separadas por comas.
+ * @return Clave de la consulta.
+ */
+string CacheBusquedas::construirClave(const string& municipio, int diaInicio, int noches, float precioMax,
+                                      float puntuacionMin, const string& amenidadesRequeridas) {
+    string clave = IndiceHash::normalizarClave(municipio);
+    clave += '|' + to_string(diaInicio) + '|' + to_string(noches);
+    clave += '|' + (precioMax < 0 ? string("-") : to_string(precioMax));
+    clave += '|' + (puntuacionMin < 0 ? string("-") : to_string(puntuacionMin));
+    clave += '|';
+
+    int numPartes = static_cast<int>(count(amenidadesRequeridas.begin(), amenidadesRequeridas.end(), ',')) + 1;
+    string* partes = new string[numPartes];
+    agregarMemoria(sizeof(string) * numPartes);
+
+    int cantidad = 0;
+    size_t inicio = 0;
+    while (inicio <= amenidadesRequeridas.size()) {
+        incrementarIteracion();
+        size_t coma = amenidadesRequeridas.find(',', inicio);
+        if (coma == string::npos) coma = amenidadesRequeridas.size();
+
+        string parte = IndiceHash::normalizarClave(amenidadesRequeridas.substr(inicio, coma - inicio));
+        inicio = coma + 1;
+        if (!parte.empty()) {
+            partes[cantidad++] = parte;
+        }
+    }
+
+    sort(partes, partes + cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        if (i > 0 && partes[i] == partes[i - 1]) continue;
+        clave += partes[i];
+        clave += ',';
+    }
+
+    agregarMemoria(-static_cast<long long>(sizeof(string) * numPartes));
+    delete[] partes;
+    return clave;
+}
@@ -0,0 +1,68 @@
+#ifndef CACHEBUSQUEDAS_H
+#define CACHEBUSQUEDAS_H
+
+#include "indicehash.h"
+
+#include <string>
+
+using namespace std;
+
+// Resultado guardado de una busqueda de alojamientos disponibles
+struct EntradaCacheBusqueda {
+    string clave;
+    string municipio;   // Municipio normalizado de la consulta
+    int diaInicio;      // Noches consultadas: dias [diaInicio, diaFin) desde la fecha base
+    int diaFin;
+    int* resultados;    // Indices de alojamientos en el orden que retorno la busqueda
+    int cantidad;
+    int anterior;       // Vecinos en la lista de uso (la mas reciente primero)
+    int siguiente;
+};
+
+// Cache LRU de resultados de busqueda, indexada por la consulta normalizada
+class CacheBusquedas {
+private:
+
+    EntradaCacheBusqueda* entradas;
+    int capacidad;
+    int numEntradas;
+
+    int masReciente;
+    int menosReciente;
+    int primeraLibre;       // Posiciones libres encadenadas por 'siguiente'
+
+    IndiceHash indiceClaves;    // clave -> posicion en entradas
+
+    void desenlazar(int pos);
+    void enlazarAlFrente(int pos);
+    void descartar(int pos);
+
+public:
+
+    // Constructor
+    CacheBusquedas(int capacidad);
+
+    // Destructor
+    ~CacheBusquedas();
+
+    // No copiable: es duena de sus arreglos
+    CacheBusquedas(const CacheBusquedas&) = delete;
+    CacheBusquedas& operator=(const CacheBusquedas&) = delete;
+
+    // Getters
+    int getNumEntradas() const { return numEntradas; }
+    int getCapacidad() const { return capacidad; }
+
+    // Metodos
+    bool buscar(const string& clave, int* destino, int& cantidad);
+    void guardar(const string& clave, const string& municipio, int diaInicio, int noches,
+                 const int* resultados, int cantidad);
+    int invalidar(const string& municipio, int diaInicio, int noches);
+    void limpiar();
+
+    // Clave canonica de una consulta de disponibilidad
+    static string construirClave(const string& municipio, int diaInicio, int noches, float precioMax,
+                                 float puntuacionMin, const string& amenidadesRequeridas);
+};
+
+#endif // CACHEBUSQUEDAS_H
@@ -0,0 +1,577 @@
+#include "catalogoalojamientos.h"
+#include "alojamiento.h"
+#include "anfitrion.h"
+#include "diccionarioamenidades.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CATALOGO_USAR_SSE2
+#endif
+
+using namespace std;
+
+/**
+ * @brief Constructor por defecto de la clase CatalogoAlojamientos.
+ *
+ * Inicializa un catálogo vacío, sin columnas reservadas.
+ */
+CatalogoAlojamientos::CatalogoAlojamientos() : numFilas(0), idMunicipio(nullptr), precio(nullptr),
+    puntuacionAnfitrion(nullptr), tipo(nullptr), amenidades(nullptr), alojamientoDeFila(nullptr), filaDeAlojamiento(nullptr),
+    municipios(nullptr), inicioMunicipio(nullptr), numMunicipios(0), inicioAmenidad(nullptr),
+    filasAmenidad(nullptr), numAmenidades(0), filasCandidatas(nullptr) {}
+
+/**
+ * @brief Destructor de la clase CatalogoAlojamientos.
+ *
+ * Libera las columnas, el diccionario de municipios y las listas de amenidades.
+ */
+CatalogoAlojamientos::~CatalogoAlojamientos() {
+    liberar();
+}
+
+/**
+ * @brief Libera la memoria de todas las columnas y deja el catálogo vacío.
+ */
+void CatalogoAlojamientos::liberar() {
+    agregarMemoria(-static_cast<long long>((sizeof(int) * 4 + sizeof(float) * 2 + sizeof(char) + sizeof(unsigned long long)) * numFilas));
+    if (inicioMunicipio) {
+        agregarMemoria(-static_cast<long long>((sizeof(string) + sizeof(int)) * numMunicipios + sizeof(int)));
+    }
+    if (inicioAmenidad) {
+        agregarMemoria(-static_cast<long long>(sizeof(int) * (numAmenidades + 1 + inicioAmenidad[numAmenidades])));
+    }
+
+    delete[] idMunicipio;
+    delete[] precio;
+    delete[] puntuacionAnfitrion;
+    delete[] tipo;
+    delete[] amenidades;
+    delete[] alojamientoDeFila;
+    delete[] filaDeAlojamiento;
+    delete[] municipios;
+    delete[] inicioMunicipio;
+    delete[] inicioAmenidad;
+    delete[] filasAmenidad;
+    delete[] filasCandidatas;
+    indiceMunicipios.limpiar();
+
+    idMunicipio = nullptr;
+    precio = nullptr;
+    puntuacionAnfitrion = nullptr;
+    tipo = nullptr;
+    amenidades = nullptr;
+    alojamientoDeFila = nullptr;
+    filaDeAlojamiento = nullptr;
+    municipios = nullptr;
+    inicioMunicipio = nullptr;
+    inicioAmenidad = nullptr;
+    filasAmenidad = nullptr;
+    filasCandidatas = nullptr;
+    numFilas = 0;
+    numMunicipios = 0;
+    numAmenidades = 0;
+}
+
+/**
+ * @brief Construye las columnas del catálogo a partir de los alojamientos cargados.
+ *
+ * Cada fila guarda solo los datos que necesitan los filtros de búsqueda: id del municipio,
+ * precio por noche, puntuación del anfitrión, tipo de alojamiento, máscara de amenidades y el
+ * índice del alojamiento en el arreglo del sistema. La puntuación se obtiene con una consulta O(1)
+ * al índice de anfitriones por documento; si el anfitrión no existe, queda en -1.
+ *
+ * Los municipios se identifican por su clave normalizada (ver `IndiceHash::normalizarClave`)
+ * y las filas se agrupan por municipio con un ordenamiento por conteo, de modo que la lista
+ * de alojamientos de cada municipio es el rango contiguo [inicio, fin) de las columnas.
+ * Dentro de ese rango las filas quedan ordenadas por precio por noche (de menor a mayor).
+ *
+ * @param alojamientos Arreglo de alojamientos del sistema.
+ * @param numAlojamientos Cantidad de alojamientos.
+ * @param anfitriones Arreglo de anfitriones del sistema.
+ * @param indiceAnfitriones Índice documento -> posición en `anfitriones`.
+ */
+void CatalogoAlojamientos::construir(const Alojamiento* alojamientos, int numAlojamientos,
+                                     const Anfitrion* anfitriones, const IndiceHash& indiceAnfitriones) {
+    liberar();
+    if (numAlojamientos <= 0) return;
+
+    // 1. Asignar id de municipio a cada alojamiento y contar cuantos hay por municipio
+    int* municipioDeAlojamiento = new int[numAlojamientos];
+    int* conteo = new int[numAlojamientos + 1]();
+    string* nombres = new string[numAlojamientos];
+    agregarMemoria((sizeof(int) * 2 + sizeof(string)) * numAlojamientos + sizeof(int));
+
+    for (int i = 0; i < numAlojamientos; ++i) {
+        incrementarIteracion();
+        const string& municipio = alojamientos[i].getMunicipio();
+        string clave = IndiceHash::normalizarClave(municipio);
+
+        int id = indiceMunicipios.buscar(clave);
+        if (id < 0) {
+            id = numMunicipios++;
+            indiceMunicipios.insertar(clave, id);
+            nombres[id] = municipio;
+        }
+        municipioDeAlojamiento[i] = id;
+        conteo[id]++;
+    }
+
+    // 2. Rango de filas de cada municipio (suma de prefijos)
+    inicioMunicipio = new int[numMunicipios + 1];
+    municipios = new string[numMunicipios];
+    agregarMemoria((sizeof(string) + sizeof(int)) * numMunicipios + sizeof(int));
+
+    inicioMunicipio[0] = 0;
+    for (int id = 0; id < numMunicipios; ++id) {
+        incrementarIteracion();
+        inicioMunicipio[id + 1] = inicioMunicipio[id] + conteo[id];
+        conteo[id] = inicioMunicipio[id]; // Se reutiliza como cursor de escritura
+        municipios[id].swap(nombres[id]);
+    }
+
+    // 3. Orden de las filas: agrupadas por municipio y, dentro de cada uno, por precio
+    numFilas = numAlojamientos;
+    idMunicipio = new int[numFilas];
+    precio = new float[numFilas];
+    puntuacionAnfitrion = new float[numFilas];
+    tipo = new char[numFilas];
+    amenidades = new unsigned long long[numFilas];
+    alojamientoDeFila = new int[numFilas];
+    filaDeAlojamiento = new int[numFilas];
+    filasCandidatas = new int[numFilas];
+    agregarMemoria((sizeof(int) * 4 + sizeof(float) * 2 + sizeof(char) + sizeof(unsigned long long)) * numFilas);
+
+    for (int i = 0; i < numAlojamientos; ++i) {
+        incrementarIteracion();
+        alojamientoDeFila[conteo[municipioDeAlojamiento[i]]++] = i;
+    }
+
+    for (int id = 0; id < numMunicipios; ++id) {
+        incrementarIteracion();
+        sort(alojamientoDeFila + inicioMunicipio[id], alojamientoDeFila + inicioMunicipio[id + 1],
+             [alojamientos](int a, int b) {
+                 incrementarIteracion();
+                 float precioA = alojamientos[a].getPrecio();
+                 float precioB = alojamientos[b].getPrecio();
+                 return precioA < precioB || (precioA == precioB && a < b);
+             });
+    }
+
+    // 4. Llenar las columnas en ese orden
+    for (int fila = 0; fila < numFilas; ++fila) {
+        incrementarIteracion();
+        int i = alojamientoDeFila[fila];
+        const Alojamiento& alojamiento = alojamientos[i];
+
+        idMunicipio[fila] = municipioDeAlojamiento[i];
+        precio[fila] = alojamiento.getPrecio();
+        tipo[fila] = alojamiento.getTipo();
+        amenidades[fila] = alojamiento.getMascaraAmenidades();
+        filaDeAlojamiento[i] = fila;
+
+        int anfitrion = indiceAnfitriones.buscar(alojamiento.getDocumentoAnfitrion());
+        puntuacionAnfitrion[fila] = (anfitrion >= 0) ? anfitriones[anfitrion].getPuntuacion() : -1;
+    }
+
+    delete[] municipioDeAlojamiento;
+    delete[] conteo;
+    delete[] nombres;
+    agregarMemoria(-static_cast<long long>((sizeof(int) * 2 + sizeof(string)) * numAlojamientos + sizeof(int)));
+
+    // 5. Listas de filas por amenidad
+    construirListasAmenidades(alojamientos);
+}
+
+/**
+ * @brief Construye la lista ordenada de filas de cada amenidad del diccionario.
+ *
+ * Las filas se recorren en orden ascendente, así que cada lista queda ordenada sin
+ * necesidad de ordenarla; como las filas están agrupadas por municipio, las filas de
+ * un municipio forman un tramo contiguo dentro de cada lista.
+ *
+ * @param alojamientos Arreglo de alojamientos del sistema.
+ */
+void CatalogoAlojamientos::construirListasAmenidades(const Alojamiento* alojamientos) {
+    numAmenidades = DiccionarioAmenidades::getNumAmenidades();
+    inicioAmenidad = new int[numAmenidades + 1]();
+    int* ids = new int[numAmenidades + 1];
+    int* cursor = new int[numAmenidades + 1];
+    agregarMemoria(sizeof(int) * 2 * (numAmenidades + 1));
+
+    // Conteo por amenidad (desplazado una posicion) y suma de prefijos
+    for (int fila = 0; fila < numFilas; ++fila) {
+        incrementarIteracion();
+        int n = alojamientos[alojamientoDeFila[fila]].obtenerIdsAmenidades(ids);
+        for (int k = 0; k < n; ++k) {
+            inicioAmenidad[ids[k] + 1]++;
+        }
+    }
+    for (int id = 0; id < numAmenidades; ++id) {
+        incrementarIteracion();
+        inicioAmenidad[id + 1] += inicioAmenidad[id];
+        cursor[id] = inicioAmenidad[id];
+    }
+
+    filasAmenidad = new int[inicioAmenidad[numAmenidades]];
+    agregarMemoria(sizeof(int) * (numAmenidades + 1 + inicioAmenidad[numAmenidades]));
+
+    for (int fila = 0; fila < numFilas; ++fila) {
+        incrementarIteracion();
+        int n = alojamientos[alojamientoDeFila[fila]].obtenerIdsAmenidades(ids);
+        for (int k = 0; k < n; ++k) {
+            filasAmenidad[cursor[ids[k]]++] = fila;
+        }
+    }
+
+    delete[] ids;
+    delete[] cursor;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * (numAmenidades + 1)));
+}
+
+/**
+ * @brief Busca el id numérico de un municipio en el diccionario.
+ *
+ * La búsqueda ignora mayúsculas, tildes y espacios sobrantes ("Medellín" equivale a "medellin").
+ *
+ * @param municipio Nombre del municipio.
+ * @return Id del municipio, o -1 si ningún alojamiento está en ese municipio.
+ */
+int CatalogoAlojamientos::buscarIdMunicipio(const string& municipio) const {
+    return indiceMunicipios.buscar(IndiceHash::normalizarClave(municipio));
+}
+
+/**
+ * @brief Filtra los alojamientos de un municipio por precio máximo, puntuación mínima y amenidades.
+ *
+ * Como las filas de cada municipio están ordenadas por precio, el precio máximo se resuelve con
+ * una búsqueda binaria: solo el prefijo [inicio, corte) del rango puede cumplir. Sin amenidades
+ * se recorre ese prefijo con `filtrarRango`. Con amenidades se toma, de la lista de cada
+ * amenidad, el tramo que cae dentro del prefijo (dos búsquedas binarias) y se elige la
+ * estrategia más barata:
+ * - Si los tramos son densos respecto al prefijo y todas las amenidades caben en la máscara,
+ *   es más rápido recorrer el prefijo con un AND de máscara por fila.
+ * - Si no, se intersecan los tramos empezando por el más corto, de modo que solo se tocan las
+ *   filas de las listas de esas amenidades, y el precio y la puntuación se evalúan al final
+ *   sobre los pocos candidatos.
+ *
+ * @param idMunicipioBuscado Id del municipio (ver `buscarIdMunicipio`). Si es negativo no hay resultados.
+ * @param precioMax Precio máximo por noche. Si es negativo, no se filtra por precio.
+ * @param puntuacionMin Puntuación mínima del anfitrión. Si es negativa, no se filtra por puntuación.
+ * @param idsAmenidades Ids (del diccionario de amenidades) que deben estar todas presentes.
+ * @param numIdsAmenidades Cantidad de ids en `idsAmenidades` (0 = sin filtro de amenidades).
+ * @param seleccion [out] Arreglo con capacidad para los alojamientos del municipio donde se escriben
+ *                  los índices (en el arreglo de alojamientos del sistema) de los que cumplen,
+ *                  ordenados de menor a mayor precio.
+ * @return Cantidad de índices escritos en `seleccion`.
+ */
+int CatalogoAlojamientos::filtrar(int idMunicipioBuscado, float precioMax, float puntuacionMin,
+                                  const int* idsAmenidades, int numIdsAmenidades, int* seleccion) {
+    if (idMunicipioBuscado < 0 || idMunicipioBuscado >= numMunicipios) return 0;
+
+    // Los limites negativos significan "sin filtro"
+    const float limitePrecio = (precioMax >= 0) ? precioMax : numeric_limits<float>::infinity();
+    const float limitePuntuacion = (puntuacionMin >= 0) ? puntuacionMin : -numeric_limits<float>::infinity();
+
+    // Filas del municipio con precio <= limite: prefijo [inicio, fin) del rango ordenado por precio
+    const int inicio = inicioMunicipio[idMunicipioBuscado];
+    const int fin = static_cast<int>(upper_bound(precio + inicio, precio + inicioMunicipio[idMunicipioBuscado + 1],
+                                                 limitePrecio) - precio);
+    if (fin == inicio) return 0;
+
+    if (numIdsAmenidades <= 0) {
+        return filtrarRango(inicio, fin, limitePrecio, limitePuntuacion, 0, seleccion);
+    }
+
+    // 1. Tramo de la lista de cada amenidad que cae en el prefijo del municipio
+    int* desde = new int[numIdsAmenidades];
+    int* hasta = new int[numIdsAmenidades];
+    agregarMemoria(sizeof(int) * 2 * numIdsAmenidades);
+
+    unsigned long long mascara = 0;
+    bool cabeEnMascara = true;
+    int total = 0;
+
+    for (int k = 0; k < numIdsAmenidades; ++k) {
+        incrementarIteracion();
+        int id = idsAmenidades[k];
+        if (id < 0 || id >= numAmenidades) {
+            desde[k] = hasta[k] = 0;
+            continue;
+        }
+        const int* lista = filasAmenidad + inicioAmenidad[id];
+        const int* listaFin = filasAmenidad + inicioAmenidad[id + 1];
+        desde[k] = static_cast<int>(lower_bound(lista, listaFin, inicio) - filasAmenidad);
+        hasta[k] = static_cast<int>(lower_bound(lista, listaFin, fin) - filasAmenidad);
+
+        mascara |= DiccionarioAmenidades::bitDe(id);
+        cabeEnMascara = cabeEnMascara && id < DiccionarioAmenidades::BITS_MASCARA;
+    }
+
+    // Tramos ordenados de menor a mayor (se intersecan primero los mas selectivos)
+    for (int k = 1; k < numIdsAmenidades; ++k) {
+        for (int j = k; j > 0 && hasta[j] - desde[j] < hasta[j - 1] - desde[j - 1]; --j) {
+            incrementarIteracion();
+            swap(desde[j], desde[j - 1]);
+            swap(hasta[j], hasta[j - 1]);
+        }
+    }
+
+    const int menor = hasta[0] - desde[0];
+
+    if (menor > 0) {
+        if (cabeEnMascara && menor * 4 >= fin - inicio) {
+            // 2a. Tramos densos: recorrido secuencial del municipio con la mascara
+            total = filtrarRango(inicio, fin, limitePrecio, limitePuntuacion, mascara, seleccion);
+        } else {
+            // 2b. Interseccion de los tramos, del mas corto al mas largo
+            const int* candidatas = filasAmenidad + desde[0];
+            int numCandidatas = menor;
+            for (int k = 1; k < numIdsAmenidades && numCandidatas > 0; ++k) {
+                numCandidatas = intersectar(candidatas, numCandidatas, filasAmenidad + desde[k],
+                                            hasta[k] - desde[k], filasCandidatas);
+                candidatas = filasCandidatas;
+            }
+            total = filtrarFilas(candidatas, numCandidatas, limitePrecio, limitePuntuacion, seleccion);
+        }
+    }
+
+    delete[] desde;
+    delete[] hasta;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * numIdsAmenidades));
+    return total;
+}
+
+/**
+ * @brief Cuenta los resultados de una búsqueda por rango de precio, rango de puntuación, tipo y amenidad.
+ *
+ * Todas las facetas se llenan en un solo recorrido de las filas seleccionadas: cada fila
+ * suma uno en su rango de precio, su rango de puntuación y su tipo, y uno por cada bit
+ * encendido de su máscara de amenidades.
+ *
+ * @param seleccion Índices (en el arreglo de alojamientos del sistema) de los resultados.
+ * @param cantidad Cantidad de índices.
+ * @param facetas [out] Conteos; se reinician antes de contar.
+ */
+void CatalogoAlojamientos::contarFacetas(const int* seleccion, int cantidad, FacetasBusqueda& facetas) const {
+    facetas = FacetasBusqueda();
+    facetas.total = cantidad;
+
+    for (int k = 0; k < cantidad; ++k) {
+        incrementarIteracion();
+        int fila = filaDeAlojamiento[seleccion[k]];
+
+        int rangoPrecio = static_cast<int>(upper_bound(FacetasBusqueda::LIMITES_PRECIO,
+                                                       FacetasBusqueda::LIMITES_PRECIO + FacetasBusqueda::NUM_RANGOS_PRECIO - 1,
+                                                       precio[fila]) - FacetasBusqueda::LIMITES_PRECIO);
+        int rangoPuntuacion = min(max(static_cast<int>(puntuacionAnfitrion[fila]), 0),
+                                  FacetasBusqueda::NUM_RANGOS_PUNTUACION - 1);
+        facetas.porPrecio[rangoPrecio]++;
+        facetas.porPuntuacion[rangoPuntuacion]++;
+        facetas.casas += (tipo[fila] == 'C');
+        facetas.apartamentos += (tipo[fila] == 'A');
+
+        unsigned long long restantes = amenidades[fila];
+        for (int id = 0; restantes != 0; ++id, restantes >>= 1) {
+            facetas.porAmenidad[id] += static_cast<int>(restantes & 1ULL);
+        }
+    }
+}
+
+/**
+ * @brief Kernel de recorrido secuencial de un rango de filas.
+ *
+ * Evalúa el predicado sin saltos: precio <= límite, puntuación >= límite y
+ * `(amenidades & requeridas) == requeridas`. Con SSE2 se evalúan 4 filas por iteración
+ * (precio y puntuación en un registro, amenidades en dos de 2 filas) y la máscara resultante
+ * se compacta en el vector de selección; sin SSE2 se usa el mismo recorrido escalar.
+ *
+ * @param inicio Primera fila del rango.
+ * @param fin Fila siguiente a la última del rango.
+ * @param limitePrecio Precio máximo por noche.
+ * @param limitePuntuacion Puntuación mínima del anfitrión.
+ * @param amenidadesRequeridas Máscara de amenidades que deben estar todas presentes (0 = sin filtro).
+ * @param seleccion [out] Índices de los alojamientos que cumplen.
+ * @return Cantidad de índices escritos en `seleccion`.
+ */
+int CatalogoAlojamientos::filtrarRango(int inicio, int fin, float limitePrecio, float limitePuntuacion,
+                                       unsigned long long amenidadesRequeridas, int* seleccion) const {
+    int total = 0;
+    int i = inicio;
+
+#ifdef CATALOGO_USAR_SSE2
+    const __m128 vPrecio = _mm_set1_ps(limitePrecio);
+    const __m128 vPuntuacion = _mm_set1_ps(limitePuntuacion);
+    const __m128i vRequeridas = _mm_set1_epi64x(static_cast<long long>(amenidadesRequeridas));
+
+    for (; i + 4 <= fin; i += 4) {
+        incrementarIteracion();
+        __m128 mPrecio = _mm_cmple_ps(_mm_loadu_ps(precio + i), vPrecio);
+        __m128 mPuntuacion = _mm_cmpge_ps(_mm_loadu_ps(puntuacionAnfitrion + i), vPuntuacion);
+        int bits = _mm_movemask_ps(_mm_and_ps(mPrecio, mPuntuacion));
+
+        // SSE2 no compara enteros de 64 bits: se comparan mitades de 32 y se exige que ambas coincidan
+        __m128i a01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(amenidades + i));
+        __m128i a23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(amenidades + i + 2));
+        __m128i e01 = _mm_cmpeq_epi32(_mm_and_si128(a01, vRequeridas), vRequeridas);
+        __m128i e23 = _mm_cmpeq_epi32(_mm_and_si128(a23, vRequeridas), vRequeridas);
+        e01 = _mm_and_si128(e01, _mm_shuffle_epi32(e01, _MM_SHUFFLE(2, 3, 0, 1)));
+        e23 = _mm_and_si128(e23, _mm_shuffle_epi32(e23, _MM_SHUFFLE(2, 3, 0, 1)));
+        bits &= _mm_movemask_pd(_mm_castsi128_pd(e01)) | (_mm_movemask_pd(_mm_castsi128_pd(e23)) << 2);
+
+        // Compactacion sin saltos: se escribe siempre y solo se avanza si la fila cumple
+        seleccion[total] = alojamientoDeFila[i];     total += bits & 1;
+        seleccion[total] = alojamientoDeFila[i + 1]; total += (bits >> 1) & 1;
+        seleccion[total] = alojamientoDeFila[i + 2]; total += (bits >> 2) & 1;
+        seleccion[total] = alojamientoDeFila[i + 3]; total += (bits >> 3) & 1;
+    }
+#endif
+
+    for (; i < fin; ++i) {
+        incrementarIteracion();
+        int cumple = (precio[i] <= limitePrecio) & (puntuacionAnfitrion[i] >= limitePuntuacion)
+                     & ((amenidades[i] & amenidadesRequeridas) == amenidadesRequeridas);
+        seleccion[total] = alojamientoDeFila[i];
+        total += cumple;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Evalúa precio y puntuación sobre una lista de filas candidatas.
+ *
+ * @param filas Filas a evaluar.
+ * @param cantidad Cantidad de filas.
+ * @param limitePrecio Precio máximo por noche.
+ * @param limitePuntuacion Puntuación mínima del anfitrión.
+ * @param seleccion [out] Índices de los alojamientos que cumplen.
+ * @return Cantidad de índices escritos en `seleccion`.
+ */
+int CatalogoAlojamientos::filtrarFilas(const int* filas, int cantidad, float limitePrecio,
+                                       float limitePuntuacion, int* seleccion) const {
+    int total = 0;
+    for (int k = 0; k < cantidad; ++k) {
+        incrementarIteracion();
+        int fila = filas[k];
+        int cumple = (precio[fila] <= limitePrecio) & (puntuacionAnfitrion[fila] >= limitePuntuacion);
+        seleccion[total] = alojamientoDeFila[fila];
+        total += cumple;
+    }
+    return total;
+}
+
+/**
+ * @brief Interseca dos listas ordenadas de filas sin repetidos.
+ *
+ * Si la segunda lista es mucho más larga se usa búsqueda galopante; si son de tamaño
+ * parecido, con SSE2 se comparan bloques de 4 contra 4 (todas las rotaciones del bloque
+ * de `b`) y el resto se mezcla de forma escalar.
+ *
+ * @param a Lista más corta.
+ * @param na Cantidad de elementos de `a`.
+ * @param b Lista más larga.
+ * @param nb Cantidad de elementos de `b`.
+ * @param salida [out] Elementos comunes, en orden. Puede ser el mismo arreglo que `a`.
+ * @return Cantidad de elementos escritos en `salida`.
+ */
+int CatalogoAlojamientos::intersectar(const int* a, int na, const int* b, int nb, int* salida) {
+    if (na == 0 || nb == 0) return 0;
+    if (nb > na * 32) {
+        return intersectarGalopando(a, na, b, nb, salida);
+    }
+
+    int total = 0;
+    int i = 0;
+    int j = 0;
+    int coincidencias = 0; // Elementos del bloque actual de a ya encontrados en b (bit k = a[i + k])
+
+#ifdef CATALOGO_USAR_SSE2
+    while (i + 4 <= na && j + 4 <= nb) {
+        incrementarIteracion();
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+
+        __m128i iguales = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        coincidencias |= _mm_movemask_ps(_mm_castsi128_ps(iguales));
+
+        int maximoA = a[i + 3];
+        int maximoB = b[j + 3];
+
+        if (maximoA <= maximoB) {
+            // El bloque de a ya no puede coincidir con mas bloques de b: se compacta sin saltos.
+            // Se escribe solo al terminar el bloque porque salida puede ser el mismo arreglo que a.
+            int a0 = a[i], a1 = a[i + 1], a2 = a[i + 2];
+            salida[total] = a0;      total += coincidencias & 1;
+            salida[total] = a1;      total += (coincidencias >> 1) & 1;
+            salida[total] = a2;      total += (coincidencias >> 2) & 1;
+            salida[total] = maximoA; total += (coincidencias >> 3) & 1;
+            coincidencias = 0;
+            i += 4;
+        }
+        j += (maximoB <= maximoA) ? 4 : 0;
+    }
+#endif
+
+    // Mezcla escalar del resto (incluye el bloque de a que quedo comparado solo en parte)
+    while (i < na && (j < nb || coincidencias != 0)) {
+        incrementarIteracion();
+        int valor = a[i];
+        bool encontrado = (coincidencias & 1) != 0;
+        coincidencias >>= 1;
+
+        while (!encontrado && j < nb && b[j] < valor) {
+            j++;
+        }
+        if (encontrado || (j < nb && b[j] == valor)) {
+            salida[total++] = valor;
+        }
+        i++;
+    }
+    return total;
+}
+
+/**
+ * @brief Interseca una lista corta con una muy larga mediante búsqueda galopante.
+ *
+ * Para cada elemento de `a` se avanza en `b` con saltos que se duplican hasta pasarlo
+ * y luego se ubica con búsqueda binaria en el último salto: O(na * log(nb / na)).
+ *
+ * @param a Lista corta.
+ * @param na Cantidad de elementos de `a`.
+ * @param b Lista larga.
+ * @param nb Cantidad de elementos de `b`.
+ * @param salida [out] Elementos comunes, en orden. Puede ser el mismo arreglo que `a`.
+ * @return Cantidad de elementos escritos en `salida`.
+ */
+int CatalogoAlojamientos::intersectarGalopando(const int* a, int na, const int* b, int nb, int* salida) {
+    int total = 0;
+    int j = 0;
+
+    for (int i = 0; i < na && j < nb; ++i) {
+        incrementarIteracion();
+        int valor = a[i];
+
+        int salto = 1;
+        while (j + salto < nb && b[j + salto] < valor) {
+            incrementarIteracion();
+            j += salto;
+            salto *= 2;
+        }
+        int limite = (j + salto < nb) ? j + salto + 1 : nb;
+        j = static_cast<int>(lower_bound(b + j, b + limite, valor) - b);
+
+        if (j < nb && b[j] == valor) {
+            salida[total++] = valor;
+            j++;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,107 @@
+#ifndef CATALOGOALOJAMIENTOS_H
+#define CATALOGOALOJAMIENTOS_H
+
+#include "diccionarioamenidades.h"
+#include "indicehash.h"
+
+#include <string>
+
+class Alojamiento;
+class Anfitrion;
+
+using namespace std;
+
+// Conteos de los resultados de una busqueda por faceta, para refinarla sin repetir consultas
+struct FacetasBusqueda {
+    static const int NUM_RANGOS_PRECIO = 6;
+    static const int NUM_RANGOS_PUNTUACION = 5;
+
+    // Limites superiores (exclusivos) de los rangos de precio por noche; el ultimo rango no tiene limite
+    static constexpr float LIMITES_PRECIO[NUM_RANGOS_PRECIO - 1] = {100000, 200000, 300000, 500000, 1000000};
+
+    int total;
+    int porPrecio[NUM_RANGOS_PRECIO];
+    int porPuntuacion[NUM_RANGOS_PUNTUACION];   // [0, 1), [1, 2), [2, 3), [3, 4), [4, 5]
+    int casas;                                  // Tipo 'C'
+    int apartamentos;                           // Tipo 'A'
+    int porAmenidad[DiccionarioAmenidades::BITS_MASCARA];  // Por id; las que no caben en la mascara no se cuentan
+};
+
+// Catalogo columnar (estructura de arreglos) con los campos que usan los filtros de busqueda.
+// Las filas estan agrupadas por municipio (las de un municipio ocupan un rango contiguo)
+// y dentro de cada municipio estan ordenadas por precio.
+class CatalogoAlojamientos {
+private:
+
+    int numFilas;
+
+    // Columnas
+    int* idMunicipio;
+    float* precio;
+    float* puntuacionAnfitrion;
+    char* tipo;
+    unsigned long long* amenidades;
+    int* alojamientoDeFila;
+    int* filaDeAlojamiento;
+
+    // Diccionario de municipios (clave normalizada -> id) y rango de filas de cada uno
+    IndiceHash indiceMunicipios;
+    string* municipios;
+    int* inicioMunicipio;
+    int numMunicipios;
+
+    // Lista ordenada de filas de cada amenidad: [inicioAmenidad[id], inicioAmenidad[id + 1]) en filasAmenidad
+    int* inicioAmenidad;
+    int* filasAmenidad;
+    int numAmenidades;
+
+    // Buffer de trabajo para las intersecciones de listas
+    int* filasCandidatas;
+
+    void liberar();
+    void construirListasAmenidades(const Alojamiento* alojamientos);
+    int filtrarRango(int inicio, int fin, float limitePrecio, float limitePuntuacion,
+                     unsigned long long amenidadesRequeridas, int* seleccion) const;
+    int filtrarFilas(const int* filas, int cantidad, float limitePrecio, float limitePuntuacion,
+                     int* seleccion) const;
+
+    static int intersectar(const int* a, int na, const int* b, int nb, int* salida);
+    static int intersectarGalopando(const int* a, int na, const int* b, int nb, int* salida);
+
+public:
+
+    // Constructor
+    CatalogoAlojamientos();
+
+    // Destructor
+    ~CatalogoAlojamientos();
+
+    // Getters
+    int getNumFilas() const { return numFilas; }
+    int getNumMunicipios() const { return numMunicipios; }
+    int getIdMunicipio(int fila) const { return idMunicipio[fila]; }
+    float getPrecio(int fila) const { return precio[fila]; }
+    float getPuntuacionAnfitrion(int fila) const { return puntuacionAnfitrion[fila]; }
+    char getTipo(int fila) const { return tipo[fila]; }
+    unsigned long long getAmenidades(int fila) const { return amenidades[fila]; }
+    int getAlojamientoDeFila(int fila) const { return alojamientoDeFila[fila]; }
+    int getFilaDeAlojamiento(int indiceAlojamiento) const { return filaDeAlojamiento[indiceAlojamiento]; }
+    float getPuntuacionDeAlojamiento(int indiceAlojamiento) const {
+        return puntuacionAnfitrion[filaDeAlojamiento[indiceAlojamiento]];
+    }
+    int getInicioMunicipio(int id) const { return inicioMunicipio[id]; }
+    int getFinMunicipio(int id) const { return inicioMunicipio[id + 1]; }
+    const string& getNombreMunicipio(int id) const { return municipios[id]; }
+
+    // Metodos
+    void construir(const Alojamiento* alojamientos, int numAlojamientos,
+                   const Anfitrion* anfitriones, const IndiceHash& indiceAnfitriones);
+    int buscarIdMunicipio(const string& municipio) const;
+    void contarFacetas(const int* seleccion, int cantidad, FacetasBusqueda& facetas) const;
+
+    // Filtrado: escribe en seleccion los alojamientos que cumplen y retorna cuantos son
+    int filtrar(int idMunicipioBuscado, float precioMax, float puntuacionMin,
+                const int* idsAmenidades, int numIdsAmenidades, int* seleccion);
+};
+
+#endif // CATALOGOALOJAMIENTOS_H
@@ -0,0 +1,138 @@
+#include "diccionarioamenidades.h"
+#include "indicehash.h"
+#include "medicionrecursos.h"
+
+#include <cctype>
+#include <stdexcept>
+
+using namespace std;
+
+const int CAPACIDAD_INICIAL_AMENIDADES = 16;
+
+// Clave normalizada -> id de la amenidad
+static IndiceHash indiceAmenidades;
+
+string* DiccionarioAmenidades::nombres = nullptr;
+int DiccionarioAmenidades::capacidad = 0;
+int DiccionarioAmenidades::numAmenidades = 0;
+
+/**
+ * @brief Obtiene el texto de una amenidad a partir de su id.
+ *
+ * @param id Id de la amenidad.
+ * @return Texto de la amenidad tal como se registró por primera vez (en minúsculas).
+ *
+ * @throws std::out_of_range si el id no existe.
+ */
+const string& DiccionarioAmenidades::getNombre(int id) {
+    if (id < 0 || id >= numAmenidades) {
+        throw out_of_range("Id de amenidad invalido");
+    }
+    return nombres[id];
+}
+
+/**
+ * @brief Registra una amenidad en el diccionario y retorna su id.
+ *
+ * La amenidad se identifica por su clave normalizada (ver `IndiceHash::normalizarClave`),
+ * así "Piscina", " piscina " y "PISCINA" comparten el mismo id. Si ya existía, solo se
+ * retorna su id; el texto mostrado es el de la primera aparición, en minúsculas.
+ *
+ * @param amenidad Texto de la amenidad.
+ * @return Id de la amenidad, o -1 si el texto está vacío.
+ */
+int DiccionarioAmenidades::internar(const string& amenidad) {
+    string clave = IndiceHash::normalizarClave(amenidad);
+    if (clave.empty()) return -1;
+
+    int id = indiceAmenidades.buscar(clave);
+    if (id >= 0) return id;
+
+    if (numAmenidades >= capacidad) {
+        int nuevaCapacidad = (capacidad == 0) ? CAPACIDAD_INICIAL_AMENIDADES : capacidad * 2;
+        string* nuevo = new string[nuevaCapacidad];
+        agregarMemoria(sizeof(string) * nuevaCapacidad);
+
+        for (int i = 0; i < numAmenidades; ++i) {
+            incrementarIteracion();
+            nuevo[i].swap(nombres[i]);
+        }
+
+        agregarMemoria(-static_cast<long long>(sizeof(string) * capacidad));
+        delete[] nombres;
+        nombres = nuevo;
+        capacidad = nuevaCapacidad;
+    }
+
+    // Texto para mostrar: sin espacios extremos y en minusculas
+    string nombre = amenidad;
+    nombre.erase(0, nombre.find_first_not_of(' '));
+    nombre.erase(nombre.find_last_not_of(' ') + 1);
+    for (size_t i = 0; i < nombre.size(); ++i) {
+        nombre[i] = static_cast<char>(tolower(static_cast<unsigned char>(nombre[i])));
+    }
+
+    id = numAmenidades++;
+    nombres[id] = nombre;
+    indiceAmenidades.insertar(clave, id);
+    return id;
+}
+
+/**
+ * @brief Busca el id de una amenidad sin registrarla.
+ *
+ * @param amenidad Texto de la amenidad (se ignoran mayúsculas, tildes y espacios sobrantes).
+ * @return Id de la amenidad, o -1 si ningún alojamiento la tiene.
+ */
+int DiccionarioAmenidades::buscar(const string& amenidad) {
+    return indiceAmenidades.buscar(IndiceHash::normalizarClave(amenidad));
+}
+
+/**
+ * @brief Convierte una lista de amenidades separadas por comas en sus ids.
+ *
+ * Los elementos vacíos y los repetidos se ignoran.
+ *
+ * @param lista Texto con amenidades separadas por comas (por ejemplo "wifi, piscina").
+ * @param ids [out] Arreglo con capacidad para `getNumAmenidades()` ids.
+ * @return Cantidad de ids escritos, o -1 si alguna amenidad no existe en el diccionario.
+ */
+int DiccionarioAmenidades::interpretarLista(const string& lista, int* ids) {
+    int cantidad = 0;
+    size_t inicio = 0;
+
+    while (inicio <= lista.size()) {
+        incrementarIteracion();
+        size_t coma = lista.find(',', inicio);
+        if (coma == string::npos) coma = lista.size();
+
+        string clave = IndiceHash::normalizarClave(lista.substr(inicio, coma - inicio));
+        inicio = coma + 1;
+        if (clave.empty()) continue;
+
+        int id = indiceAmenidades.buscar(clave);
+        if (id < 0) return -1;
+
+        bool repetida = false;
+        for (int i = 0; i < cantidad; ++i) {
+            incrementarIteracion();
+            repetida = repetida || ids[i] == id;
+        }
+        if (!repetida) {
+            ids[cantidad++] = id;
+        }
+    }
+    return cantidad;
+}
+
+/**
+ * @brief Elimina todas las amenidades registradas y libera la memoria del diccionario.
+ */
+void DiccionarioAmenidades::limpiar() {
+    agregarMemoria(-static_cast<long long>(sizeof(string) * capacidad));
+    delete[] nombres;
+    nombres = nullptr;
+    capacidad = 0;
+    numAmenidades = 0;
+    indiceAmenidades.limpiar();
+}
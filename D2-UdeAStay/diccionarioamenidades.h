@@ -0,0 +1,38 @@
+#ifndef DICCIONARIOAMENIDADES_H
+#define DICCIONARIOAMENIDADES_H
+
+#include <string>
+
+using namespace std;
+
+// Diccionario global de amenidades: cada texto distinto se guarda una sola vez y se
+// identifica con un id. Los alojamientos solo guardan los ids (como bits de una mascara).
+class DiccionarioAmenidades {
+private:
+
+    static string* nombres;
+    static int capacidad;
+    static int numAmenidades;
+
+public:
+
+    // Cantidad de amenidades que caben en la mascara de un alojamiento
+    static const int BITS_MASCARA = 64;
+
+    // Getters
+    static int getNumAmenidades() { return numAmenidades; }
+    static const string& getNombre(int id);
+
+    // Bit de la mascara que representa una amenidad (0 si el id no cabe en la mascara)
+    static unsigned long long bitDe(int id) {
+        return (id >= 0 && id < BITS_MASCARA) ? (1ULL << id) : 0ULL;
+    }
+
+    // Metodos
+    static int internar(const string& amenidad);
+    static int buscar(const string& amenidad);
+    static int interpretarLista(const string& lista, int* ids);
+    static void limpiar();
+};
+
+#endif // DICCIONARIOAMENIDADES_H
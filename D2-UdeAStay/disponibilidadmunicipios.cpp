@@ -0,0 +1,128 @@
+#include "disponibilidadmunicipios.h"
+#include "agendaalojamientos.h"
+#include "catalogoalojamientos.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Constructor de la clase DisponibilidadMunicipios.
+ *
+ * Los contadores quedan vacíos (sin municipios ni días) hasta la primera construcción.
+ */
+DisponibilidadMunicipios::DisponibilidadMunicipios() : numMunicipios(0), totalAlojamientos(nullptr),
+    diaBase(0), numDias(0), ocupados(nullptr) {}
+
+/**
+ * @brief Destructor de la clase DisponibilidadMunicipios.
+ */
+DisponibilidadMunicipios::~DisponibilidadMunicipios() {
+    liberar();
+}
+
+/**
+ * @brief Libera los contadores y deja la ventana vacía.
+ */
+void DisponibilidadMunicipios::liberar() {
+    delete[] totalAlojamientos;
+    delete[] ocupados;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * (numMunicipios + numMunicipios * numDias)));
+
+    totalAlojamientos = nullptr;
+    ocupados = nullptr;
+    numMunicipios = 0;
+    numDias = 0;
+}
+
+/**
+ * @brief Construye los contadores de noches ocupadas a partir de la agenda de ocupación.
+ *
+ * Por cada alojamiento se recorren sus intervalos en orden de entrada y solo se cuenta la
+ * parte que no cubre ya un intervalo anterior (reservaciones superpuestas no ocupan dos veces
+ * la misma noche). Cada tramo se marca con una diferencia al inicio y otra al final, y una
+ * suma acumulada por municipio deja los ocupados de cada noche: el costo es proporcional a
+ * los intervalos más las celdas, no a las noches reservadas.
+ *
+ * @param agenda Agenda de ocupación con las reservaciones activas.
+ * @param catalogo Catálogo de búsqueda, de donde sale el municipio de cada alojamiento.
+ * @param primerDia Primera noche de la ventana, contada desde la fecha base.
+ * @param dias Cantidad de noches de la ventana.
+ *
+ * @throws std::invalid_argument si la cantidad de días no es positiva.
+ */
+void DisponibilidadMunicipios::construir(const AgendaAlojamientos& agenda, const CatalogoAlojamientos& catalogo,
+                                         int primerDia, int dias) {
+    if (dias <= 0) {
+        throw invalid_argument("La ventana de disponibilidad debe tener al menos un dia.");
+    }
+    liberar();
+
+    numMunicipios = catalogo.getNumMunicipios();
+    diaBase = primerDia;
+    numDias = dias;
+    totalAlojamientos = new int[max(numMunicipios, 1)];
+    // Una columna extra por municipio recibe las diferencias que cierran en el ultimo dia
+    int* diferencias = new int[numMunicipios * (numDias + 1) + 1]();
+    agregarMemoria(sizeof(int) * (numMunicipios * (numDias + 1) + 1));
+
+    const int finVentana = diaBase + numDias;
+    for (int m = 0; m < numMunicipios; ++m) {
+        totalAlojamientos[m] = catalogo.getFinMunicipio(m) - catalogo.getInicioMunicipio(m);
+
+        int* diferenciasMunicipio = diferencias + m * (numDias + 1);
+        for (int fila = catalogo.getInicioMunicipio(m); fila < catalogo.getFinMunicipio(m); ++fila) {
+            int alojamiento = catalogo.getAlojamientoDeFila(fila);
+            const IntervaloOcupado* lista = agenda.getIntervalos(alojamiento);
+            int cubiertoHasta = diaBase;
+
+            for (int k = 0; k < agenda.getNumIntervalos(alojamiento); ++k) {
+                incrementarIteracion();
+                if (lista[k].inicio >= finVentana) break;
+
+                int inicio = max(lista[k].inicio, cubiertoHasta);
+                int fin = min(lista[k].fin, finVentana);
+                if (inicio < fin) {
+                    diferenciasMunicipio[inicio - diaBase]++;
+                    diferenciasMunicipio[fin - diaBase]--;
+                    cubiertoHasta = fin;
+                }
+            }
+        }
+    }
+
+    ocupados = new int[max(numMunicipios * numDias, 1)];
+    for (int m = 0; m < numMunicipios; ++m) {
+        const int* diferenciasMunicipio = diferencias + m * (numDias + 1);
+        int acumulado = 0;
+        for (int d = 0; d < numDias; ++d) {
+            incrementarIteracion();
+            acumulado += diferenciasMunicipio[d];
+            ocupados[m * numDias + d] = acumulado;
+        }
+    }
+    agregarMemoria(sizeof(int) * (numMunicipios + numMunicipios * numDias));
+
+    delete[] diferencias;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * (numMunicipios * (numDias + 1) + 1)));
+}
+
+/**
+ * @brief Marca una noche de un municipio como ocupada o libre.
+ *
+ * El llamador decide cuándo cambia la noche: al reservar, solo si el alojamiento estaba
+ * libre; al cancelar, solo si quedó libre. Las noches fuera de la ventana se ignoran.
+ *
+ * @param municipio Id del municipio en el catálogo.
+ * @param dia Noche, contada desde la fecha base.
+ * @param signo 1 si la noche pasa a estar ocupada; -1 si queda libre.
+ */
+void DisponibilidadMunicipios::registrar(int municipio, int dia, int signo) {
+    if (municipio < 0 || municipio >= numMunicipios || !cubre(dia)) {
+        return;
+    }
+    incrementarIteracion();
+    ocupados[municipio * numDias + (dia - diaBase)] += signo;
+}
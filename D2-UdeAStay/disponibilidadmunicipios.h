@@ -0,0 +1,50 @@
+#ifndef DISPONIBILIDADMUNICIPIOS_H
+#define DISPONIBILIDADMUNICIPIOS_H
+
+class AgendaAlojamientos;
+class CatalogoAlojamientos;
+
+using namespace std;
+
+// Alojamientos ocupados por municipio y noche en una ventana de dias.
+// Las celdas forman un arreglo denso [municipio][dia]; los libres de una noche son el total
+// del municipio menos los ocupados, asi que un mapa de disponibilidad se lee sin tocar la agenda.
+class DisponibilidadMunicipios {
+private:
+
+    int numMunicipios;
+    int* totalAlojamientos;     // Alojamientos de cada municipio
+    int diaBase;                // Primera noche cubierta, desde la fecha base
+    int numDias;                // Noches cubiertas: [diaBase, diaBase + numDias)
+    int* ocupados;              // [municipio * numDias + (dia - diaBase)]
+
+    void liberar();
+
+public:
+
+    // Constructor
+    DisponibilidadMunicipios();
+
+    // Destructor
+    ~DisponibilidadMunicipios();
+
+    // No copiable: es duena de sus arreglos
+    DisponibilidadMunicipios(const DisponibilidadMunicipios&) = delete;
+    DisponibilidadMunicipios& operator=(const DisponibilidadMunicipios&) = delete;
+
+    // Getters
+    int getNumMunicipios() const { return numMunicipios; }
+    int getDiaBase() const { return diaBase; }
+    int getNumDias() const { return numDias; }
+    int getTotalAlojamientos(int municipio) const { return totalAlojamientos[municipio]; }
+    bool cubre(int dia) const { return dia >= diaBase && dia < diaBase + numDias; }
+    int getOcupados(int municipio, int dia) const { return ocupados[municipio * numDias + (dia - diaBase)]; }
+    int getLibres(int municipio, int dia) const { return totalAlojamientos[municipio] - getOcupados(municipio, dia); }
+
+    // Metodos
+    void construir(const AgendaAlojamientos& agenda, const CatalogoAlojamientos& catalogo,
+                   int primerDia, int dias);
+    void registrar(int municipio, int dia, int signo);
+};
+
+#endif // DISPONIBILIDADMUNICIPIOS_H
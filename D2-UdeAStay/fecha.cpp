@@ -235,6 +235,36 @@ int Fecha::aDiasDesdeFechaBase() const {
     return totalDias;
 }
 
+/**
+ * @brief Construye la fecha que corresponde a un número de días desde el 01/01/1900.
+ *
+ * Es la operación inversa de `aDiasDesdeFechaBase`.
+ *
+ * @param dias Días transcurridos desde el 01/01/1900 (0 = 01/01/1900).
+ * @return Fecha correspondiente.
+ */
+Fecha Fecha::desdeDiasFechaBase(int dias) {
+    incrementarIteracion();
+    int diasMes[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int a = 1900;
+
+    while (true) {
+        int diasAnio = (a % 4 == 0 && (a % 100 != 0 || a % 400 == 0)) ? 366 : 365;
+        if (dias < diasAnio) break;
+        dias -= diasAnio;
+        a++;
+    }
+
+    diasMes[1] = (a % 4 == 0 && (a % 100 != 0 || a % 400 == 0)) ? 29 : 28;
+    int m = 1;
+    while (dias >= diasMes[m - 1]) {
+        dias -= diasMes[m - 1];
+        m++;
+    }
+
+    return Fecha(dias + 1, m, a);
+}
+
 /**
  * @brief Compara si dos fechas son iguales.
  *
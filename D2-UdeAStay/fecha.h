@@ -15,6 +15,11 @@ public:
     Fecha(int d, int m, int a);
     Fecha(const string& fechaStr);
 
+    // Getters
+    int getDia() const { return dia; }
+    int getMes() const { return mes; }
+    int getAnio() const { return anio; }
+
     bool esValida() const;
     bool yaPaso() const;
 
@@ -26,6 +31,7 @@ public:
     Fecha calcularFechaFinal(int noches) const;
 
     int aDiasDesdeFechaBase() const;
+    static Fecha desdeDiasFechaBase(int dias);
 
     // Operadores
     bool operator==(const Fecha& otra) const;
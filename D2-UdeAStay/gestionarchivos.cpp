@@ -3,8 +3,10 @@
 #include "huesped.h"
 #include "alojamiento.h"
 #include "reservacion.h"
+#include "solicitudreservacion.h"
 #include "medicionrecursos.h"
 
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -35,6 +37,24 @@ int GestionArchivos::contarLineas(const string& nombreArchivo) {
     return contador;
 }
 
+/**
+ * @brief Indica si un archivo no vacío termina sin salto de línea.
+ *
+ * `actualizarArchivoReservaciones` no escribe el salto de la última línea; antes de agregar
+ * líneas al final hay que completarlo para no pegarlas a la anterior.
+ *
+ * @param nombreArchivo Nombre del archivo.
+ * @return true si el último carácter del archivo no es '\n'; false si termina en '\n', está
+ *         vacío o no existe.
+ */
+bool GestionArchivos::faltaSaltoDeLineaFinal(const string& nombreArchivo) {
+    ifstream archivo(nombreArchivo, ios::binary);
+    if (!archivo.is_open() || !archivo.seekg(-1, ios::end)) return false;
+    char ultimo = '\n';
+    archivo.get(ultimo);
+    return ultimo != '\n';
+}
+
 /**
  * @brief Carga los datos de anfitriones desde un archivo y los almacena en un arreglo dinámico.
  *
@@ -247,32 +267,7 @@ void GestionArchivos::cargarReservaciones(Reservacion*& reservaciones, int& cant
 
     while (getline(archivo, linea)) {
         incrementarIteracion();
-        istringstream ss(linea);
-        string codigo, fecha_entrada, duracion_estadiaStr, codigo_alojamiento,
-            documento, metodo_pagoStr, fecha_pago, montoStr, anotacion;
-
-        getline(ss, codigo, '|');
-        getline(ss, fecha_entrada, '|');
-        getline(ss, duracion_estadiaStr, '|');
-        getline(ss, codigo_alojamiento, '|');
-        getline(ss, documento, '|');
-        getline(ss, metodo_pagoStr, '|');
-        getline(ss, fecha_pago, '|');
-        getline(ss, montoStr, '|');
-        getline(ss, anotacion);
-
-        char metodo_pago = '\0';
-        string metodo_mostrar = metodo_pagoStr; // Para mostrar el texto completo
-
-        if (metodo_pagoStr == "TC" || metodo_pagoStr == "PSE") {
-            metodo_pago = metodo_pagoStr[0];
-        }
-
-        int duracion_estadia = stoi(duracion_estadiaStr);
-        float monto = stof(montoStr);
-
-        reservaciones[i++] = Reservacion(codigo, fecha_entrada, duracion_estadia, codigo_alojamiento, documento,
-        metodo_pago, fecha_pago, monto, anotacion);
+        reservaciones[i++] = interpretarLineaReservacion(linea);
 
         // reservaciones[i] = Reservacion(codigo, fecha_entrada, duracion_estadia,codigo_alojamiento, documento, metodo_pago,
         // fecha_pago, monto, anotacion);
@@ -300,6 +295,67 @@ void GestionArchivos::cargarReservaciones(Reservacion*& reservaciones, int& cant
     cantidad = i;
 }
 
+/**
+ * @brief Carga un lote de solicitudes de reservación desde un archivo de texto.
+ *
+ * Cada línea tiene los campos codigo_alojamiento|documento_huesped|DD/MM/AAAA|noches|metodo|anotaciones,
+ * donde el método de pago es 'T' (tarjeta de crédito) o 'P' (PSE) y las anotaciones son
+ * opcionales. Las líneas vacías se ignoran; una línea con noches no numéricas se carga con
+ * 0 noches, de modo que la reservación por lotes la reporta como datos inválidos.
+ *
+ * @param nombreArchivo Nombre del archivo del lote.
+ * @param solicitudes [out] Arreglo dinámico con las solicitudes leídas.
+ * @param cantidad [out] Cantidad de solicitudes leídas.
+ * @return true si el archivo se pudo abrir; false en caso contrario.
+ *
+ * @note El arreglo retornado se reserva con new[]: el llamador debe liberarlo con delete[].
+ */
+bool GestionArchivos::cargarSolicitudesReservacion(const string& nombreArchivo, SolicitudReservacion*& solicitudes,
+                                                   int& cantidad) {
+    solicitudes = nullptr;
+    cantidad = 0;
+    ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    int total = contarLineas(nombreArchivo);
+    if (total == 0) {
+        return true;
+    }
+
+    solicitudes = new SolicitudReservacion[total];
+    agregarMemoria(sizeof(SolicitudReservacion) * total);
+
+    string linea;
+    while (getline(archivo, linea) && cantidad < total) {
+        incrementarIteracion();
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        if (linea.empty()) continue;
+
+        istringstream ss(linea);
+        string fechaStr, nochesStr, metodoStr;
+        SolicitudReservacion& solicitud = solicitudes[cantidad++];
+        getline(ss, solicitud.codigoAlojamiento, '|');
+        getline(ss, solicitud.documentoHuesped, '|');
+        getline(ss, fechaStr, '|');
+        getline(ss, nochesStr, '|');
+        getline(ss, metodoStr, '|');
+        getline(ss, solicitud.anotaciones);
+
+        solicitud.fechaEntrada = Fecha(fechaStr);
+        try {
+            solicitud.noches = stoi(nochesStr);
+        } catch (...) {
+            solicitud.noches = 0;
+        }
+        solicitud.metodoPago = metodoStr.empty() ? ' ' : metodoStr[0];
+    }
+
+    // El llamador libera el arreglo contando solo las solicitudes leidas
+    agregarMemoria(-static_cast<long long>(sizeof(SolicitudReservacion) * (total - cantidad)));
+    return true;
+}
+
 /**
  * @brief Guarda una nueva reservación en el archivo "Reservaciones.txt".
  *
@@ -309,12 +365,14 @@ void GestionArchivos::cargarReservaciones(Reservacion*& reservaciones, int& cant
  * @param reservacion Objeto de tipo Reservacion que contiene los datos a guardar.
  */
 void GestionArchivos::guardarReservacion(const Reservacion& reservacion) {
+    bool completarLinea = faltaSaltoDeLineaFinal("Reservaciones.txt");
     ofstream archivo("Reservaciones.txt", ios::app);
     if (!archivo.is_open()) {
         incrementarIteracion();
         cout << "Error: No se pudo abrir el archivo para guardar la reservacion.\n";
         return;
     }
+    if (completarLinea) archivo << "\n";
 
     // Formatear método de pago para archivo
     string metodoPagoStr = formatearMetodoPago(reservacion.getMetodoPago());
@@ -334,6 +392,35 @@ void GestionArchivos::guardarReservacion(const Reservacion& reservacion) {
     cout << "Reservacion guardada exitosamente en el archivo.\n";
 }
 
+/**
+ * @brief Agrega varias reservaciones al archivo "Reservaciones.txt" con una sola apertura.
+ *
+ * Las líneas se arman en memoria y se escriben juntas al final del archivo; lo usan las
+ * reservaciones por lotes (ver `Sistema::reservarEnLote`).
+ *
+ * @param reservaciones Reservaciones a guardar.
+ * @param cantidad Cantidad de reservaciones.
+ * @return true si se escribieron; false si el archivo no se pudo abrir o escribir.
+ */
+bool GestionArchivos::guardarReservaciones(const Reservacion* reservaciones, int cantidad) {
+    ostringstream lineas;
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        lineas << formatearLineaReservacion(reservaciones[i]) << "\n";
+    }
+
+    bool completarLinea = faltaSaltoDeLineaFinal("Reservaciones.txt");
+    ofstream archivo("Reservaciones.txt", ios::app);
+    if (!archivo.is_open()) {
+        incrementarIteracion();
+        cout << "Error: No se pudo abrir el archivo para guardar las reservaciones.\n";
+        return false;
+    }
+    if (completarLinea) archivo << "\n";
+    archivo << lineas.str();
+    return archivo.good();
+}
+
 /**
  * @brief Sobrescribe el archivo "Reservaciones.txt" con todas las reservaciones actuales.
  *
@@ -374,50 +461,91 @@ void GestionArchivos::actualizarArchivoReservaciones(Reservacion* reservaciones,
 /**
  * @brief Guarda un conjunto de reservaciones finalizadas en el archivo histórico.
  *
- * Este método agrega una sección al final del archivo "HistoricoReservaciones.txt"
- * con información sobre la fecha de corte y la cantidad de reservaciones almacenadas,
- * seguida por el detalle de cada reservación.
+ * Las reservaciones se agregan a los segmentos mensuales del histórico (ver
+ * `ArchivoHistorico::guardar`): en texto con un índice disperso por fecha de entrada,
+ * huésped y alojamiento, o en formato columnar si se activó con `setHistoricoColumnar`.
  *
  * @param reservaciones Arreglo de reservaciones que se desea guardar en el histórico.
  * @param cantidad Número de reservaciones a guardar.
  * @param fechaCorte Fecha de corte que indica hasta cuándo se consideran finalizadas las reservaciones.
- * @return true Si el archivo fue abierto y escrito correctamente.
- * @return false Si no se pudo abrir el archivo.
+ * @return true Si todos los segmentos se escribieron correctamente.
+ * @return false Si no se pudo abrir alguno de los archivos del histórico.
  */
 bool GestionArchivos::guardarReservacionesHistorico(Reservacion* reservaciones, int cantidad, const string& fechaCorte) {
-    // Abrir archivo historico en modo append
-    ofstream archivo("HistoricoReservaciones.txt", ios::app);
-    if (!archivo.is_open()) {
+    if (!historico.guardar(reservaciones, cantidad, fechaCorte)) {
         incrementarIteracion();
         cout << "Error: No se pudo abrir el archivo historico.\n";
         return false;
     }
+    return true;
+}
 
-    // Agregar marca de tiempo y fecha de corte de la actualizacion
-    archivo << "# === ACTUALIZACION HISTORICO ===\n";
-    archivo << "# Fecha de procesamiento: " << Fecha::obtenerFechaActual() << "\n";
-    archivo << "# Fecha de corte: " << fechaCorte << "\n";  // Usar string directamente
-    archivo << "# Reservaciones finalizadas: " << cantidad << "\n";
-    archivo << "# ================================\n";
+/**
+ * @brief Pasa el histórico de un solo archivo (formato anterior) a segmentos mensuales.
+ *
+ * Si existe "HistoricoReservaciones.txt" con lotes delimitados por comentarios, sus
+ * reservaciones se reparten en los segmentos y el archivo se renombra con la extensión
+ * ".migrado" para no importarlo dos veces.
+ *
+ * @return Cantidad de reservaciones migradas (0 si no había archivo anterior).
+ */
+int GestionArchivos::migrarHistoricoUnico() {
+    return historico.importarArchivoUnico();
+}
 
-    // Guardar reservaciones finalizadas
-    for (int i = 0; i < cantidad; i++) {
-        incrementarIteracion();
-        string metodoPagoStr = formatearMetodoPago(reservaciones[i].getMetodoPago());
-        archivo << reservaciones[i].getCodigo() << "|"
-                << reservaciones[i].getFechaEntrada() << "|"
-                << reservaciones[i].getDuracion() << "|"
-                << reservaciones[i].getCodigoAlojamiento() << "|"
-                << reservaciones[i].getDocumento() << "|"
-                << metodoPagoStr << "|"
-                << reservaciones[i].getFechaPago() << "|"
-                << fixed << setprecision(0) << reservaciones[i].getMonto() << "|"
-                << reservaciones[i].getAnotacion() << "\n";
+/**
+ * @brief Convierte una reservación en una línea de los archivos de reservaciones.
+ *
+ * @param reservacion Reservación a convertir.
+ * @return Línea con los campos separados por '|' (sin salto de línea final).
+ */
+string GestionArchivos::formatearLineaReservacion(const Reservacion& reservacion) {
+    ostringstream linea;
+    linea << reservacion.getCodigo() << "|"
+          << reservacion.getFechaEntrada() << "|"
+          << reservacion.getDuracion() << "|"
+          << reservacion.getCodigoAlojamiento() << "|"
+          << reservacion.getDocumento() << "|"
+          << formatearMetodoPago(reservacion.getMetodoPago()) << "|"
+          << reservacion.getFechaPago() << "|"
+          << fixed << setprecision(0) << reservacion.getMonto() << "|"
+          << reservacion.getAnotacion();
+    return linea.str();
+}
+
+/**
+ * @brief Construye una reservación a partir de una línea de los archivos de reservaciones.
+ *
+ * @param linea Línea con los campos separados por '|'.
+ * @return Reservación leída.
+ *
+ * @throws std::invalid_argument si la duración o el monto no son números.
+ */
+Reservacion GestionArchivos::interpretarLineaReservacion(const string& linea) {
+    istringstream ss(linea);
+    string codigo, fecha_entrada, duracion_estadiaStr, codigo_alojamiento,
+        documento, metodo_pagoStr, fecha_pago, montoStr, anotacion;
+
+    getline(ss, codigo, '|');
+    getline(ss, fecha_entrada, '|');
+    getline(ss, duracion_estadiaStr, '|');
+    getline(ss, codigo_alojamiento, '|');
+    getline(ss, documento, '|');
+    getline(ss, metodo_pagoStr, '|');
+    getline(ss, fecha_pago, '|');
+    getline(ss, montoStr, '|');
+    getline(ss, anotacion);
+
+    char metodo_pago = '\0';
+    if (metodo_pagoStr == "TC" || metodo_pagoStr == "PSE") {
+        metodo_pago = metodo_pagoStr[0];
     }
 
-    archivo << "# === FIN ACTUALIZACION ===\n\n";
-    archivo.close();
-    return true;
+    int duracion_estadia = stoi(duracion_estadiaStr);
+    float monto = stof(montoStr);
+
+    return Reservacion(codigo, fecha_entrada, duracion_estadia, codigo_alojamiento, documento,
+                       metodo_pago, fecha_pago, monto, anotacion);
 }
 
 /**
@@ -502,15 +630,19 @@ string GestionArchivos::cargarUltimaFechaCorteHistorico() {
  * de reservaciones.
  *
  * @param fecha Fecha de corte que se desea guardar.
+ * @return true si la fecha quedó escrita en el archivo.
  */
-void GestionArchivos::guardarUltimaFechaCorteHistorico(const string& fecha) {
+bool GestionArchivos::guardarUltimaFechaCorteHistorico(const string& fecha) {
     incrementarIteracion();
     ofstream archivo("fecha_corte_historico.txt");
     if (archivo) {
         archivo << fecha;
         agregarMemoria(fecha.size());
         archivo.close();
-    } else {
+    }
+    if (!archivo) {
         cerr << "Error al guardar la fecha de corte del historico.\n";
+        return false;
     }
+    return true;
 }
@@ -1,20 +1,27 @@
 #ifndef GESTIONARCHIVOS_H
 #define GESTIONARCHIVOS_H
 
+#include "archivohistorico.h"
+
 #include <string>
 
 class Anfitrion;
 class Huesped;
 class Alojamiento;
 class Reservacion;
+struct SolicitudReservacion;
 
 using namespace std;
 
 class GestionArchivos {
 private:
 
+    // Historico de reservaciones segmentado por mes de entrada
+    ArchivoHistorico historico;
+
     int contarLineas(const string& nombreArchivo);
-    string formatearMetodoPago(char metodo);
+    static bool faltaSaltoDeLineaFinal(const string& nombreArchivo);
+    static string formatearMetodoPago(char metodo);
 
 public:
 
@@ -26,12 +33,22 @@ public:
     void cargarHuespedes(Huesped*& huespedes, int& cantidad);
     void cargarAlojamientos(Alojamiento*& alojamientos, int& cantidad);
     void cargarReservaciones(Reservacion*& reservaciones, int& cantidad);
+    bool cargarSolicitudesReservacion(const string& nombreArchivo, SolicitudReservacion*& solicitudes,
+                                      int& cantidad);
 
     // Nuevos metodos para guardar
     void guardarReservacion(const Reservacion& reservacion);
+    bool guardarReservaciones(const Reservacion* reservaciones, int cantidad);
     void actualizarArchivoReservaciones(Reservacion* reservaciones, int cantidad);
     bool guardarReservacionesHistorico(Reservacion* reservaciones, int cantidad,
     const string& fechaCorte);
+    int migrarHistoricoUnico();
+    const ArchivoHistorico& getHistorico() const { return historico; }
+    void setHistoricoColumnar(bool columnar) { historico.setColumnar(columnar); }
+
+    // Formato de una reservacion en los archivos (campos separados por '|')
+    static string formatearLineaReservacion(const Reservacion& reservacion);
+    static Reservacion interpretarLineaReservacion(const string& linea);
 
     // Nuevos metodos para el ID
     int cargarUltimoIdReservacion();
@@ -39,7 +56,7 @@ public:
 
     // Nuevos metodos para manejo de fecha de corte historico
     string cargarUltimaFechaCorteHistorico();
-    void guardarUltimaFechaCorteHistorico(const string& fecha);
+    bool guardarUltimaFechaCorteHistorico(const string& fecha);
 
 };
 
@@ -2,14 +2,30 @@
 #include "sistema.h"
 #include "alojamiento.h"
 #include "anfitrion.h"
+#include "catalogoalojamientos.h"
+#include "diccionarioamenidades.h"
 #include "fecha.h"
 #include "medicionrecursos.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <cstdlib>
 
+// Resultados de busqueda que se muestran por pagina
+const int TAMANO_PAGINA = 10;
+
+// Dias maximos entre la primera y la ultima fecha de entrada de una busqueda flexible
+const int MAX_DIAS_VENTANA_FLEXIBLE = 90;
+
+// Respuestas de seleccionarAlojamiento para cambiar de pagina
+const int PAGINA_SIGUIENTE = -2;
+const int PAGINA_ANTERIOR = -3;
+
+// Alojamientos ocupados que se sugieren, con su proxima fecha, cuando una busqueda no tiene resultados
+const int MAX_SUGERENCIAS_OCUPADOS = 5;
+
 /**
  * @brief Constructor por defecto de la clase Huesped.
  *
@@ -168,6 +184,44 @@ Fecha Huesped::solicitarFechaEntrada() {
     return fechaEntrada;
 }
 
+/**
+ * @brief Solicita la última fecha de entrada aceptable de una búsqueda con fechas flexibles.
+ *
+ * Valida el formato y que la fecha no sea anterior a `desde` ni esté a más de
+ * `MAX_DIAS_VENTANA_FLEXIBLE` días de ella.
+ *
+ * @param desde Primera fecha de entrada aceptable.
+ * @return Fecha límite válida.
+ */
+Fecha Huesped::solicitarFechaLimite(const Fecha& desde) {
+    incrementarIteracion();
+    Fecha fechaLimite;
+    string fechaStr;
+
+    while (true) {
+        incrementarIteracion();
+        cout << "Ingrese la ultima fecha de entrada aceptable (DD/MM/AAAA): ";
+        cin >> fechaStr;
+
+        fechaLimite = Fecha(fechaStr);
+        if (!fechaLimite.esValida()) {
+            cout << "Fecha invalida. Formato correcto: DD/MM/AAAA\n";
+            continue;
+        }
+        int dias = fechaLimite.aDiasDesdeFechaBase() - desde.aDiasDesdeFechaBase();
+        if (dias < 0) {
+            cout << "La fecha limite no puede ser anterior a la primera fecha de entrada.\n";
+            continue;
+        }
+        if (dias > MAX_DIAS_VENTANA_FLEXIBLE) {
+            cout << "La ventana no puede superar " << MAX_DIAS_VENTANA_FLEXIBLE << " dias.\n";
+            continue;
+        }
+        break;
+    }
+    return fechaLimite;
+}
+
 /**
  * @brief Solicita al huésped el nombre del municipio de destino.
  *
@@ -290,6 +344,55 @@ float Huesped::solicitarPuntuacionMinima() {
     return puntuacion;
 }
 
+/**
+ * @brief Solicita al huésped las amenidades que debe tener el alojamiento.
+ *
+ * Pregunta si desea exigir amenidades. Si responde 's' o 'S', lee una lista
+ * separada por comas (por ejemplo "wifi, piscina"). Si no, retorna una cadena vacía.
+ *
+ * @return Lista de amenidades requeridas, o cadena vacía si no se desea filtrar.
+ */
+string Huesped::solicitarAmenidades() {
+    incrementarIteracion();
+    char opc;
+    cout << "Desea exigir amenidades? (s/n): ";
+    cin >> opc;
+
+    if (opc != 's' && opc != 'S') return ""; // Sin filtro
+
+    string amenidades;
+    cout << "Ingrese las amenidades separadas por comas: ";
+    cin.ignore();
+    getline(cin, amenidades);
+    return amenidades;
+}
+
+/**
+ * @brief Solicita al huésped el orden en que desea ver los resultados de la búsqueda.
+ *
+ * Repite la solicitud hasta recibir una opción válida.
+ *
+ * @return 'P' (precio por noche), 'R' (puntuación del anfitrión) o 'T' (costo total).
+ */
+char Huesped::solicitarCriterioOrden() {
+    incrementarIteracion();
+    while (true) {
+        incrementarIteracion();
+        cout << "Ordenar resultados por:\n";
+        cout << "1. Precio por noche (menor primero)\n";
+        cout << "2. Puntuacion del anfitrion (mayor primero)\n";
+        cout << "3. Costo total de la estadia (menor primero)\n";
+        cout << "Seleccione una opcion: ";
+        string entrada;
+        cin >> entrada;
+
+        if (entrada == "1") return 'P';
+        if (entrada == "2") return 'R';
+        if (entrada == "3") return 'T';
+        cout << "Opcion invalida.\n";
+    }
+}
+
 /**
  * @brief Solicita al huésped seleccionar un método de pago válido.
  *
@@ -344,49 +447,177 @@ string Huesped::solicitarAnotaciones() {
 }
 
 /**
- * @brief Permite al huésped seleccionar un alojamiento de un arreglo de alojamientos disponibles.
+ * @brief Muestra cuántos resultados de la búsqueda hay por rango de precio, puntuación, tipo y amenidad.
  *
- * Muestra los alojamientos con un índice numerado, y solicita al usuario seleccionar uno.
- * El usuario puede cancelar la selección ingresando 0.
+ * Solo se listan los valores con al menos un resultado, para que el huésped sepa qué
+ * criterios puede agregar sin dejar la búsqueda vacía.
  *
- * @param disponibles Arreglo de alojamientos disponibles.
- * @param cantidad Número de alojamientos disponibles.
- * @return Índice del alojamiento seleccionado (base 0), o -1 si se cancela.
+ * @param facetas Conteos calculados por `Sistema::buscarAlojamientosOrdenados`.
+ */
+void Huesped::mostrarFacetas(const FacetasBusqueda& facetas) {
+    incrementarIteracion();
+    cout << "\n=== REFINAR BUSQUEDA (" << facetas.total << " resultados) ===\n";
+
+    cout << "Precio por noche:";
+    for (int r = 0; r < FacetasBusqueda::NUM_RANGOS_PRECIO; ++r) {
+        incrementarIteracion();
+        if (facetas.porPrecio[r] == 0) continue;
+        cout << fixed << setprecision(0) << "  ";
+        if (r == 0) {
+            cout << "menos de $" << FacetasBusqueda::LIMITES_PRECIO[0];
+        } else if (r == FacetasBusqueda::NUM_RANGOS_PRECIO - 1) {
+            cout << "$" << FacetasBusqueda::LIMITES_PRECIO[r - 1] << " o mas";
+        } else {
+            cout << "$" << FacetasBusqueda::LIMITES_PRECIO[r - 1] << "-" << FacetasBusqueda::LIMITES_PRECIO[r];
+        }
+        cout << ": " << facetas.porPrecio[r];
+    }
+
+    cout << "\nPuntuacion del anfitrion:";
+    for (int r = 0; r < FacetasBusqueda::NUM_RANGOS_PUNTUACION; ++r) {
+        incrementarIteracion();
+        if (facetas.porPuntuacion[r] == 0) continue;
+        cout << "  " << r << "-" << r + 1 << ": " << facetas.porPuntuacion[r];
+    }
+
+    cout << "\nTipo:  Casa: " << facetas.casas << "  Apartamento: " << facetas.apartamentos;
+
+    cout << "\nAmenidades:";
+    int numIds = min(DiccionarioAmenidades::getNumAmenidades(), DiccionarioAmenidades::BITS_MASCARA);
+    for (int id = 0; id < numIds; ++id) {
+        incrementarIteracion();
+        if (facetas.porAmenidad[id] == 0) continue;
+        cout << "  " << DiccionarioAmenidades::getNombre(id) << ": " << facetas.porAmenidad[id];
+    }
+    cout << "\n";
+}
+
+/**
+ * @brief Permite al huésped seleccionar un alojamiento de una página de resultados.
+ *
+ * Muestra los alojamientos de la página con un número global (continúa entre páginas) y el
+ * costo total de la estadía, y solicita al usuario seleccionar uno. El usuario puede cancelar
+ * con 0 o moverse a la página siguiente ('s') o anterior ('a') cuando existan.
+ *
+ * @param alojamientos Arreglo de alojamientos del sistema.
+ * @param pagina Índices (dentro de `alojamientos`) de los alojamientos de la página.
+ * @param cantidadPagina Número de alojamientos en la página.
+ * @param desplazamiento Cantidad de resultados anteriores a la página.
+ * @param total Cantidad total de resultados de la búsqueda.
+ * @param noches Noches de la estadía (para mostrar el costo total).
+ * @return Posición del alojamiento seleccionado dentro de `pagina` (base 0), -1 si se cancela,
+ *         o `PAGINA_SIGUIENTE` / `PAGINA_ANTERIOR` si se pide cambiar de página.
  */
-int Huesped::seleccionarAlojamiento(Alojamiento* disponibles, int cantidad) {
+int Huesped::seleccionarAlojamiento(const Alojamiento* alojamientos, const int* pagina, int cantidadPagina,
+                                    int desplazamiento, int total, int noches) {
     incrementarIteracion();
+    bool haySiguiente = desplazamiento + cantidadPagina < total;
+    bool hayAnterior = desplazamiento > 0;
+
     // Mostrar opciones
-    cout << "\n=== ALOJAMIENTOS DISPONIBLES ===\n";
-    for (int i = 0; i < cantidad; ++i) {
+    cout << "\n=== ALOJAMIENTOS DISPONIBLES (" << (desplazamiento + 1) << "-"
+         << (desplazamiento + cantidadPagina) << " de " << total << ") ===\n";
+    for (int i = 0; i < cantidadPagina; ++i) {
         incrementarIteracion();
-        cout << "[" << (i + 1) << "] ";
-        disponibles[i].mostrar();
+        const Alojamiento& alojamiento = alojamientos[pagina[i]];
+        cout << "[" << (desplazamiento + i + 1) << "] ";
+        alojamiento.mostrar();
+        cout << "Costo total (" << noches << " noche(s)): $" << fixed << setprecision(0)
+             << alojamiento.getPrecio() * noches << "\n";
         cout << "\n";
     }
 
     // Seleccion
-    int seleccion;
     while (true) {
         incrementarIteracion();
-        cout << "Seleccione una opcion (1-" << cantidad << ") o 0 para cancelar: ";
-        cin >> seleccion;
+        cout << "Seleccione una opcion (" << (desplazamiento + 1) << "-" << (desplazamiento + cantidadPagina) << ")";
+        if (haySiguiente) cout << ", 's' para la siguiente pagina";
+        if (hayAnterior) cout << ", 'a' para la anterior";
+        cout << " o 0 para cancelar: ";
 
-        if (seleccion == 0) return -1; // Cancelar
-        if (seleccion >= 1 && seleccion <= cantidad) {
+        string entrada;
+        cin >> entrada;
+
+        if (haySiguiente && (entrada == "s" || entrada == "S")) return PAGINA_SIGUIENTE;
+        if (hayAnterior && (entrada == "a" || entrada == "A")) return PAGINA_ANTERIOR;
+
+        try {
+            int seleccion = stoi(entrada);
+            if (seleccion == 0) return -1; // Cancelar
+            if (seleccion > desplazamiento && seleccion <= desplazamiento + cantidadPagina) {
+                incrementarIteracion();
+                return seleccion - desplazamiento - 1; // indice en la pagina, basado en 0
+            }
+        } catch (...) {
             incrementarIteracion();
-            return seleccion - 1; // indice basado en 0
         }
         cout << "Opcion invalida.\n";
     }
 }
 
+/**
+ * @brief Sugiere los alojamientos que cumplen los criterios pero están ocupados en esas fechas.
+ *
+ * Muestra los `MAX_SUGERENCIAS_OCUPADOS` que se liberan primero, cada uno con la primera fecha
+ * de entrada en que tiene libres las noches pedidas (ver
+ * `Sistema::obtenerProximasFechasDisponibles`).
+ *
+ * @param sistema Puntero al sistema que gestiona alojamientos y reservaciones.
+ * @param fechaEntrada Fecha de entrada pedida.
+ * @param municipio Municipio de la búsqueda.
+ * @param noches Noches de la estadía.
+ * @param precioMax Precio máximo por noche (negativo: sin filtro).
+ * @param puntuacionMin Puntuación mínima del anfitrión (negativa: sin filtro).
+ * @param amenidades Amenidades requeridas separadas por comas.
+ */
+void Huesped::mostrarProximasFechasDisponibles(Sistema* sistema, const Fecha& fechaEntrada, const string& municipio,
+                                               int noches, float precioMax, float puntuacionMin,
+                                               const string& amenidades) {
+    int nOcupados = 0;
+    const int* ocupados = sistema->buscarAlojamientosOcupados(municipio, fechaEntrada, noches, precioMax,
+                                                              puntuacionMin, amenidades, nOcupados);
+    if (nOcupados == 0) {
+        return;
+    }
+    Fecha* proximas = sistema->obtenerProximasFechasDisponibles(ocupados, nOcupados, fechaEntrada, noches);
+
+    // Posiciones de los que se liberan primero (a igual fecha, el mas barato)
+    int nSugeridos = min(nOcupados, MAX_SUGERENCIAS_OCUPADOS);
+    int* orden = new int[nOcupados];
+    agregarMemoria(sizeof(int) * nOcupados);
+    for (int i = 0; i < nOcupados; ++i) {
+        orden[i] = i;
+    }
+    partial_sort(orden, orden + nSugeridos, orden + nOcupados, [proximas](int a, int b) {
+        incrementarIteracion();
+        if (!(proximas[a] == proximas[b])) return proximas[a] < proximas[b];
+        return a < b;
+    });
+
+    cout << "Alojamientos ocupados en esas fechas y su proxima fecha disponible:\n";
+    for (int i = 0; i < nSugeridos; ++i) {
+        incrementarIteracion();
+        const Alojamiento& alojamiento = sistema->getAlojamientos()[ocupados[orden[i]]];
+        cout << "- " << alojamiento.getCodigo() << " " << alojamiento.getNombre()
+             << " ($" << fixed << setprecision(0) << alojamiento.getPrecio() << " por noche): desde "
+             << proximas[orden[i]].toString() << "\n";
+    }
+    cout << "\n";
+
+    delete[] orden;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * nOcupados));
+    delete[] proximas;
+    agregarMemoria(-static_cast<long long>(sizeof(Fecha) * nOcupados));
+}
+
 /**
  * @brief Método principal para que el huésped realice una reserva de alojamiento.
  *
  * Este método gestiona todo el proceso de reserva:
- * - Solicita datos al usuario (fecha, municipio, noches, precio máximo y puntuación mínima).
- * - Busca alojamientos disponibles en el sistema con esos criterios.
- * - Permite al usuario seleccionar un alojamiento.
+ * - Solicita datos al usuario (fecha, municipio, noches, precio máximo, puntuación mínima,
+ *   amenidades y orden de los resultados).
+ * - Busca alojamientos disponibles en el sistema con esos criterios, una página a la vez.
+ * - Permite al usuario seleccionar un alojamiento o cambiar de página.
  * - Crea una nueva reservación.
  * - Muestra la confirmación de la reserva.
  *
@@ -404,17 +635,50 @@ void Huesped::ReservarAlojamiento(Sistema* sistema) {
         int noches = solicitarCantidadNoches();
         float precioMax = solicitarPrecioMaximo();
         float puntuacionMin = solicitarPuntuacionMinima();
+        string amenidades = solicitarAmenidades();
+        char criterio = solicitarCriterioOrden();
 
-        // 2. Buscar alojamientos disponibles
+        // 2. Buscar alojamientos disponibles y 3. permitir seleccion, una pagina a la vez
+        int desplazamiento = 0;
+        int nEnPagina = 0;
         int nDisponibles = 0;
-        Alojamiento* disponibles = sistema->buscarAlojamientosDisponibles(
-            municipio, fechaEntrada, noches, precioMax, puntuacionMin, nDisponibles
-            );
+        int seleccion = -1;
+        const int* pagina = nullptr;
+        bool facetasMostradas = false;
+        FacetasBusqueda facetas;
+
+        while (true) {
+            incrementarIteracion();
+            pagina = sistema->buscarAlojamientosOrdenados(
+                municipio, fechaEntrada, noches, precioMax, puntuacionMin, amenidades,
+                criterio, TAMANO_PAGINA, desplazamiento, nEnPagina, nDisponibles,
+                facetasMostradas ? nullptr : &facetas
+                );
+            if (nDisponibles == 0) break;
+
+            // Los conteos para refinar se muestran una vez, con la primera pagina
+            if (!facetasMostradas) {
+                mostrarFacetas(facetas);
+                facetasMostradas = true;
+            }
+
+            seleccion = seleccionarAlojamiento(sistema->getAlojamientos(), pagina, nEnPagina,
+                                               desplazamiento, nDisponibles, noches);
+            if (seleccion == PAGINA_SIGUIENTE) {
+                desplazamiento += TAMANO_PAGINA;
+            } else if (seleccion == PAGINA_ANTERIOR) {
+                desplazamiento -= TAMANO_PAGINA;
+            } else {
+                break;
+            }
+        }
 
         if (nDisponibles == 0) {
             incrementarIteracion();
             char opcion;
             cout << "\nNo hay alojamientos disponibles con esos criterios.\n";
+            mostrarProximasFechasDisponibles(sistema, fechaEntrada, municipio, noches, precioMax,
+                                             puntuacionMin, amenidades);
             cout << "Desea intentar con otros criterios? (s/n): ";
             cin >> opcion;
 
@@ -426,26 +690,125 @@ void Huesped::ReservarAlojamiento(Sistema* sistema) {
             }
         }
 
-        // 3. Permitir seleccion
-        int seleccion = seleccionarAlojamiento(disponibles, nDisponibles);
         if (seleccion == -1) {
-            delete[] disponibles;
             return; // Usuario cancelo
         }
+        const Alojamiento& alojamiento = sistema->getAlojamientos()[pagina[seleccion]];
 
         // 4. Crear reservacion
         Reservacion* nuevaReservacion = sistema->crearReservacion(
-            disponibles[seleccion], fechaEntrada, noches, this
+            alojamiento, fechaEntrada, noches, this
             );
 
         // 5. Mostrar confirmacion
-        mostrarConfirmacionReservacion(*nuevaReservacion, disponibles[seleccion]);
+        if (nuevaReservacion != nullptr) {
+            mostrarConfirmacionReservacion(*nuevaReservacion, alojamiento);
+        }
 
-        delete[] disponibles;
         break; // exito -> salir del ciclo
     }
 }
 
+/**
+ * @brief Reserva un alojamiento buscando en una ventana de fechas de entrada.
+ *
+ * El huésped indica la primera y la última fecha de entrada que acepta; una sola búsqueda
+ * encuentra los alojamientos con algún hueco de las noches pedidas en esa ventana. Después
+ * de elegir el alojamiento se muestran todas sus fechas de entrada posibles y el huésped
+ * escoge una de ellas.
+ *
+ * @param sistema Puntero al sistema que gestiona alojamientos y reservaciones.
+ */
+void Huesped::ReservarConFechasFlexibles(Sistema* sistema) {
+    incrementarIteracion();
+    while (true) {
+        // 1. Recopilar datos del usuario
+        cout << "\n--- BUSQUEDA CON FECHAS FLEXIBLES ---\n";
+        cout << "Primera fecha de entrada aceptable.\n";
+        Fecha desde = solicitarFechaEntrada();
+        Fecha hasta = solicitarFechaLimite(desde);
+        string municipio = solicitarMunicipio();
+        int noches = solicitarCantidadNoches();
+        float precioMax = solicitarPrecioMaximo();
+        float puntuacionMin = solicitarPuntuacionMinima();
+        string amenidades = solicitarAmenidades();
+
+        // 2. Una sola busqueda para toda la ventana
+        int nEncontrados = 0;
+        const int* encontrados = sistema->buscarAlojamientosFlexibles(
+            municipio, desde, hasta, noches, precioMax, puntuacionMin, amenidades, nEncontrados
+            );
+
+        if (nEncontrados == 0) {
+            incrementarIteracion();
+            char opcion;
+            cout << "\nNo hay alojamientos disponibles en esa ventana de fechas.\n";
+            cout << "Desea intentar con otros criterios? (s/n): ";
+            cin >> opcion;
+            if (tolower(opcion) == 'n') return;
+            continue;
+        }
+
+        // 3. Seleccion del alojamiento, una pagina a la vez
+        int desplazamiento = 0;
+        int seleccion;
+        while (true) {
+            incrementarIteracion();
+            int nEnPagina = (nEncontrados - desplazamiento < TAMANO_PAGINA) ? nEncontrados - desplazamiento : TAMANO_PAGINA;
+            seleccion = seleccionarAlojamiento(sistema->getAlojamientos(), encontrados + desplazamiento,
+                                               nEnPagina, desplazamiento, nEncontrados, noches);
+            if (seleccion == PAGINA_SIGUIENTE) {
+                desplazamiento += TAMANO_PAGINA;
+            } else if (seleccion == PAGINA_ANTERIOR) {
+                desplazamiento -= TAMANO_PAGINA;
+            } else {
+                break;
+            }
+        }
+        if (seleccion == -1) return; // Usuario cancelo
+
+        int indiceAlojamiento = encontrados[desplazamiento + seleccion];
+        const Alojamiento& alojamiento = sistema->getAlojamientos()[indiceAlojamiento];
+
+        // 4. Fechas de entrada posibles del alojamiento elegido
+        int numRangos = 0;
+        Fecha* rangos = sistema->obtenerFechasInicioPosibles(indiceAlojamiento, desde, hasta, noches, numRangos);
+
+        cout << "\nFechas de entrada posibles para " << alojamiento.getNombre() << ":\n";
+        for (int i = 0; i < numRangos; ++i) {
+            incrementarIteracion();
+            if (rangos[2 * i] == rangos[2 * i + 1]) {
+                cout << "- " << rangos[2 * i].toString() << "\n";
+            } else {
+                cout << "- Del " << rangos[2 * i].toString() << " al " << rangos[2 * i + 1].toString() << "\n";
+            }
+        }
+
+        Fecha fechaEntrada;
+        while (true) {
+            incrementarIteracion();
+            fechaEntrada = solicitarFechaEntrada();
+            bool posible = false;
+            for (int i = 0; i < numRangos && !posible; ++i) {
+                incrementarIteracion();
+                posible = fechaEntrada >= rangos[2 * i] && fechaEntrada <= rangos[2 * i + 1];
+            }
+            if (posible) break;
+            cout << "Esa fecha no esta entre las fechas posibles.\n";
+        }
+
+        agregarMemoria(-static_cast<long long>(sizeof(Fecha) * 2 * numRangos));
+        delete[] rangos;
+
+        // 5. Crear reservacion y mostrar confirmacion
+        Reservacion* nuevaReservacion = sistema->crearReservacion(alojamiento, fechaEntrada, noches, this);
+        if (nuevaReservacion != nullptr) {
+            mostrarConfirmacionReservacion(*nuevaReservacion, alojamiento);
+        }
+        break;
+    }
+}
+
 /**
  * @brief Muestra en consola el comprobante de confirmación de una reservación.
  *
@@ -491,13 +854,14 @@ void Huesped::mostrarConfirmacionReservacion(const Reservacion& reservacion,
 }
 
 /**
- * @brief Muestra todas las reservaciones del huésped en consola, separadas en futuras y pasadas.
+ * @brief Muestra todas las reservaciones del huésped en consola: futuras, pasadas e históricas.
  *
  * Este método:
  * - Muestra el nombre y documento del huésped.
- * - Solicita al sistema las reservaciones asociadas a este huésped.
+ * - Solicita al sistema el historial del huésped (ver `Sistema::obtenerHistorialHuesped`).
  * - Si no hay reservaciones, informa al usuario y espera que presione Enter.
- * - Si hay reservaciones, muestra primero las futuras y luego las pasadas, con detalle.
+ * - Si hay reservaciones, muestra primero las futuras, luego las pasadas y por último las
+ *   que ya se movieron al histórico, con detalle.
  * - Al final, muestra el total de reservaciones y espera que el usuario presione Enter para continuar.
  *
  * @param sistema Puntero al sistema que gestiona las reservaciones y alojamientos.
@@ -507,9 +871,9 @@ void Huesped::mostrarReservaciones(Sistema* sistema) {
     cout << "Nombre: " << this->getNombre() << "\n";
     cout << "Documento: " << this->getDocumento() << "\n\n";
 
-    int totalFuturas, totalPasadas;
-    Reservacion* reservaciones = sistema->obtenerReservaciones(
-        this->getDocumento(), totalFuturas, totalPasadas);
+    int totalFuturas, totalPasadas, totalHistoricas;
+    Reservacion* reservaciones = sistema->obtenerHistorialHuesped(
+        this->getDocumento(), totalFuturas, totalPasadas, totalHistoricas);
 
     if (reservaciones == nullptr) {
         cout << "No tiene reservaciones registradas.\n\n";
@@ -540,9 +904,18 @@ void Huesped::mostrarReservaciones(Sistema* sistema) {
     } else {
         cout << "No tiene reservaciones pasadas.\n";
     }
+
+    // Mostrar reservaciones del historico (ya finalizadas)
+    if (totalHistoricas > 0) {
+        int inicioHistoricas = totalFuturas + totalPasadas;
+        cout << "\n=== HISTORICO DE ESTADIAS (" << totalHistoricas << ") ===\n";
+        for (int i = inicioHistoricas; i < inicioHistoricas + totalHistoricas; i++) {
+            reservaciones[i].mostrarDetalle(i - inicioHistoricas + 1, false, sistema);
+        }
+    }
     delete[] reservaciones;
 
-    cout << "\nTotal de reservaciones: " << (totalFuturas + totalPasadas) << "\n\n";
+    cout << "\nTotal de reservaciones: " << (totalFuturas + totalPasadas + totalHistoricas) << "\n\n";
     cout << "Presione Enter para continuar...";
     cin.ignore();
     cin.get();
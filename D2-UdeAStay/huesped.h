@@ -50,20 +50,33 @@ public:
 
     //Metodos para reservas
     void ReservarAlojamiento(Sistema* sistema);
+    void ReservarConFechasFlexibles(Sistema* sistema);
     void mostrarReservaciones(Sistema* sistema);
     void anularReservacion(Sistema* sistema);
 
     // Métodos de entrada de datos
     Fecha solicitarFechaEntrada();
+    Fecha solicitarFechaLimite(const Fecha& desde);
     string solicitarMunicipio();
     int solicitarCantidadNoches();
     float solicitarPrecioMaximo();
     float solicitarPuntuacionMinima();
+    string solicitarAmenidades();
+    char solicitarCriterioOrden();
     char solicitarMetodoPago();
     string solicitarAnotaciones();
 
+    // Conteos por faceta de los resultados de una busqueda
+    void mostrarFacetas(const FacetasBusqueda& facetas);
+
     // Métodos de selección
-    int seleccionarAlojamiento(Alojamiento* disponibles, int cantidad);
+    int seleccionarAlojamiento(const Alojamiento* alojamientos, const int* pagina, int cantidadPagina,
+                               int desplazamiento, int total, int noches);
+
+    // Alojamientos ocupados que cumplen los criterios, con su proxima fecha disponible
+    void mostrarProximasFechasDisponibles(Sistema* sistema, const Fecha& fechaEntrada, const string& municipio,
+                                          int noches, float precioMax, float puntuacionMin,
+                                          const string& amenidades);
 
     // Métodos de confirmación
     void mostrarConfirmacionReservacion(const Reservacion& reservacion, const Alojamiento& alojamiento);
@@ -0,0 +1,249 @@
+#include "indicehash.h"
+#include "medicionrecursos.h"
+
+#include <cctype>
+
+using namespace std;
+
+// Equivalencia sin tilde de los caracteres Latin-1 0xC0-0xFF (mayusculas y minusculas)
+static const char SIN_TILDE[] = "aaaaaaaceeeeiiiidnoooooxouuuuyts"
+                                "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+const int CAPACIDAD_INICIAL_HASH = 16;
+
+/**
+ * @brief Constructor por defecto de la clase IndiceHash.
+ *
+ * Crea una tabla vacía; la memoria se reserva con la primera inserción.
+ */
+IndiceHash::IndiceHash() : claves(nullptr), valores(nullptr), ocupadas(nullptr),
+    capacidad(0), numElementos(0) {}
+
+/**
+ * @brief Destructor de la clase IndiceHash.
+ *
+ * Libera los arreglos de claves, valores y estado de las posiciones.
+ */
+IndiceHash::~IndiceHash() {
+    limpiar();
+}
+
+/**
+ * @brief Elimina todos los elementos y libera la memoria de la tabla.
+ */
+void IndiceHash::limpiar() {
+    agregarMemoria(-static_cast<long long>((sizeof(string) + sizeof(int) + sizeof(bool)) * capacidad));
+    delete[] claves;
+    delete[] valores;
+    delete[] ocupadas;
+    claves = nullptr;
+    valores = nullptr;
+    ocupadas = nullptr;
+    capacidad = 0;
+    numElementos = 0;
+}
+
+/**
+ * @brief Calcula el hash FNV-1a de una clave.
+ *
+ * @param clave Texto a resumir.
+ * @return Valor hash de 32 bits.
+ */
+unsigned int IndiceHash::calcularHash(const string& clave) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < clave.size(); ++i) {
+        hash ^= static_cast<unsigned char>(clave[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Busca la posición de una clave con sondeo lineal.
+ *
+ * @param clave Clave a localizar.
+ * @return Posición que contiene la clave o, si no existe, la primera posición libre de su secuencia.
+ */
+int IndiceHash::buscarPosicion(const string& clave) const {
+    int mascara = capacidad - 1;
+    int pos = static_cast<int>(calcularHash(clave) & mascara);
+
+    while (ocupadas[pos] && claves[pos] != clave) {
+        incrementarIteracion();
+        pos = (pos + 1) & mascara;
+    }
+    return pos;
+}
+
+/**
+ * @brief Cambia la capacidad de la tabla y reubica todos los elementos.
+ *
+ * @param nuevaCapacidad Nueva capacidad (potencia de 2).
+ */
+void IndiceHash::redimensionar(int nuevaCapacidad) {
+    string* clavesAnteriores = claves;
+    int* valoresAnteriores = valores;
+    bool* ocupadasAnteriores = ocupadas;
+    int capacidadAnterior = capacidad;
+
+    claves = new string[nuevaCapacidad];
+    valores = new int[nuevaCapacidad];
+    ocupadas = new bool[nuevaCapacidad]();
+    capacidad = nuevaCapacidad;
+    agregarMemoria((sizeof(string) + sizeof(int) + sizeof(bool)) * nuevaCapacidad);
+
+    for (int i = 0; i < capacidadAnterior; ++i) {
+        incrementarIteracion();
+        if (ocupadasAnteriores[i]) {
+            int pos = buscarPosicion(clavesAnteriores[i]);
+            claves[pos].swap(clavesAnteriores[i]);
+            valores[pos] = valoresAnteriores[i];
+            ocupadas[pos] = true;
+        }
+    }
+
+    agregarMemoria(-static_cast<long long>((sizeof(string) + sizeof(int) + sizeof(bool)) * capacidadAnterior));
+    delete[] clavesAnteriores;
+    delete[] valoresAnteriores;
+    delete[] ocupadasAnteriores;
+}
+
+/**
+ * @brief Reserva espacio para una cantidad de elementos sin redimensionar durante la carga.
+ *
+ * @param cantidad Número de elementos esperados.
+ */
+void IndiceHash::reservar(int cantidad) {
+    int nuevaCapacidad = CAPACIDAD_INICIAL_HASH;
+    while (nuevaCapacidad * 7 < cantidad * 10) {
+        nuevaCapacidad *= 2;
+    }
+    if (nuevaCapacidad > capacidad) {
+        redimensionar(nuevaCapacidad);
+    }
+}
+
+/**
+ * @brief Inserta una clave con su valor asociado.
+ *
+ * La tabla crece al doble cuando su ocupación supera el 70%.
+ *
+ * @param clave Clave a insertar.
+ * @param valor Valor asociado (se recomienda no negativo, ya que -1 indica ausencia en `buscar`).
+ * @return true si se insertó; false si la clave ya existía (en ese caso no se modifica).
+ */
+bool IndiceHash::insertar(const string& clave, int valor) {
+    if ((numElementos + 1) * 10 > capacidad * 7) {
+        redimensionar(capacidad == 0 ? CAPACIDAD_INICIAL_HASH : capacidad * 2);
+    }
+
+    int pos = buscarPosicion(clave);
+    if (ocupadas[pos]) {
+        return false;
+    }
+
+    claves[pos] = clave;
+    valores[pos] = valor;
+    ocupadas[pos] = true;
+    numElementos++;
+    return true;
+}
+
+/**
+ * @brief Busca el valor asociado a una clave.
+ *
+ * @param clave Clave a buscar.
+ * @return Valor asociado, o -1 si la clave no existe.
+ */
+int IndiceHash::buscar(const string& clave) const {
+    incrementarIteracion();
+    if (numElementos == 0) return -1;
+
+    int pos = buscarPosicion(clave);
+    return ocupadas[pos] ? valores[pos] : -1;
+}
+
+/**
+ * @brief Elimina una clave de la tabla.
+ *
+ * Para no dejar huecos en las secuencias de sondeo, los elementos siguientes del mismo
+ * grupo se desplazan hacia atrás cuando la posición liberada les corresponde mejor.
+ *
+ * @param clave Clave a eliminar.
+ * @return true si la clave existía y se eliminó; false en caso contrario.
+ */
+bool IndiceHash::eliminar(const string& clave) {
+    if (numElementos == 0) return false;
+
+    int pos = buscarPosicion(clave);
+    if (!ocupadas[pos]) return false;
+
+    int mascara = capacidad - 1;
+    int hueco = pos;
+    int siguiente = (pos + 1) & mascara;
+
+    while (ocupadas[siguiente]) {
+        incrementarIteracion();
+        int ideal = static_cast<int>(calcularHash(claves[siguiente]) & mascara);
+
+        // El elemento puede ocupar el hueco si su posicion ideal no esta entre el hueco y el mismo
+        if (((siguiente - ideal) & mascara) >= ((siguiente - hueco) & mascara)) {
+            claves[hueco].swap(claves[siguiente]);
+            valores[hueco] = valores[siguiente];
+            hueco = siguiente;
+        }
+        siguiente = (siguiente + 1) & mascara;
+    }
+
+    claves[hueco].clear();
+    ocupadas[hueco] = false;
+    numElementos--;
+    return true;
+}
+
+/**
+ * @brief Obtiene la forma canónica de un texto para usarlo como clave.
+ *
+ * Elimina espacios al inicio y al final, reduce los espacios internos a uno solo,
+ * convierte a minúsculas y quita tildes y diéresis, tanto en UTF-8 como en Latin-1.
+ * Así "Medellín", " MEDELLIN " y "medellin" producen la misma clave.
+ *
+ * @param texto Texto original.
+ * @return Clave normalizada.
+ */
+string IndiceHash::normalizarClave(const string& texto) {
+    string clave;
+    clave.reserve(texto.size());
+    bool espacioPendiente = false;
+
+    for (size_t i = 0; i < texto.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(texto[i]);
+        char normalizado;
+
+        if (c == 0xC3 && i + 1 < texto.size()) {
+            // UTF-8 de dos bytes para U+00C0 - U+00FF
+            unsigned char siguiente = static_cast<unsigned char>(texto[i + 1]);
+            if (siguiente >= 0x80 && siguiente <= 0xBF) {
+                normalizado = SIN_TILDE[siguiente - 0x80];
+                i++;
+            } else {
+                normalizado = static_cast<char>(c);
+            }
+        } else if (c >= 0xC0) {
+            // Latin-1 (archivos guardados en ANSI)
+            normalizado = SIN_TILDE[c - 0xC0];
+        } else if (isspace(c)) {
+            espacioPendiente = !clave.empty();
+            continue;
+        } else {
+            normalizado = static_cast<char>(tolower(c));
+        }
+
+        if (espacioPendiente) {
+            clave += ' ';
+            espacioPendiente = false;
+        }
+        clave += normalizado;
+    }
+    return clave;
+}
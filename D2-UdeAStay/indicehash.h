@@ -0,0 +1,49 @@
+#ifndef INDICEHASH_H
+#define INDICEHASH_H
+
+#include <string>
+
+using namespace std;
+
+// Tabla hash de direccionamiento abierto que asocia claves de texto con un entero
+class IndiceHash {
+private:
+
+    string* claves;
+    int* valores;
+    bool* ocupadas;
+
+    int capacidad;
+    int numElementos;
+
+    static unsigned int calcularHash(const string& clave);
+    int buscarPosicion(const string& clave) const;
+    void redimensionar(int nuevaCapacidad);
+
+public:
+
+    // Constructor
+    IndiceHash();
+
+    // Destructor
+    ~IndiceHash();
+
+    // No copiable: es dueno de sus arreglos
+    IndiceHash(const IndiceHash&) = delete;
+    IndiceHash& operator=(const IndiceHash&) = delete;
+
+    // Getters
+    int getNumElementos() const { return numElementos; }
+
+    // Metodos
+    void reservar(int cantidad);
+    bool insertar(const string& clave, int valor);
+    int buscar(const string& clave) const;
+    bool eliminar(const string& clave);
+    void limpiar();
+
+    // Clave canonica: sin espacios extremos, en minusculas y sin tildes
+    static string normalizarClave(const string& texto);
+};
+
+#endif // INDICEHASH_H
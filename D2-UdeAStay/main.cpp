@@ -1,14 +1,79 @@
 #include "sistema.h"
+#include "gestionarchivos.h"
 #include "medicionrecursos.h"
 
 #include <iostream>
+#include <stdexcept>
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
     Sistema sistema;
     sistema.cargarDatos();
 
+    // Las reservaciones finalizadas salen del conjunto activo antes de que lo lea cualquier comando
+    sistema.ejecutarCorteHistoricoAutomatico();
+
+    // Comando por lotes: --reporte-ocupacion [AAAA]
+    if (argc >= 2 && string(argv[1]) == "--reporte-ocupacion") {
+        try {
+            int anio = (argc >= 3) ? stoi(argv[2]) : Fecha(Fecha::obtenerFechaActual()).getAnio();
+            string nombreArchivo = "ReporteOcupacion_" + to_string(anio) + ".txt";
+            if (!sistema.generarReporteOcupacion(anio, nombreArchivo)) return 1;
+            cout << "Reporte de ocupacion " << anio << " guardado en " << nombreArchivo << "\n";
+        } catch (const exception& e) {
+            cout << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Comando por lotes: --resumen-pagos DD/MM/AAAA DD/MM/AAAA
+    if (argc >= 4 && string(argv[1]) == "--resumen-pagos") {
+        Fecha desde(argv[2]);
+        Fecha hasta(argv[3]);
+        if (!desde.esValida() || !hasta.esValida() || hasta < desde) {
+            cout << "Error: Rango de fechas invalido.\n";
+            return 1;
+        }
+        sistema.mostrarResumenPagos(desde, hasta);
+        return 0;
+    }
+
+    // Comando por lotes: --disponibilidad MUNICIPIO DD/MM/AAAA [NOCHES]
+    if (argc >= 4 && string(argv[1]) == "--disponibilidad") {
+        try {
+            int noches = (argc >= 5) ? stoi(argv[4]) : 30;
+            sistema.mostrarDisponibilidadMunicipio(argv[2], Fecha(argv[3]), noches);
+        } catch (const exception& e) {
+            cout << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Comando por lotes: --reservar-lote ARCHIVO
+    if (argc >= 3 && string(argv[1]) == "--reservar-lote") {
+        SolicitudReservacion* solicitudes = nullptr;
+        int cantidad = 0;
+        GestionArchivos gestor;
+        if (!gestor.cargarSolicitudesReservacion(argv[2], solicitudes, cantidad)) {
+            cout << "Error: No se pudo abrir el archivo " << argv[2] << ".\n";
+            return 1;
+        }
+        int reservadas = sistema.reservarEnLote(solicitudes, cantidad);
+        for (int i = 0; i < cantidad; ++i) {
+            cout << (i + 1) << "|" << solicitudes[i].codigoAlojamiento << "|" << solicitudes[i].documentoHuesped
+                 << "|" << SolicitudReservacion::describirResultado(solicitudes[i].resultado);
+            if (!solicitudes[i].codigoReservacion.empty()) cout << "|" << solicitudes[i].codigoReservacion;
+            cout << "\n";
+        }
+        cout << reservadas << " de " << cantidad << " solicitudes reservadas.\n";
+        delete[] solicitudes;
+        agregarMemoria(-static_cast<long long>(sizeof(SolicitudReservacion) * cantidad));
+        return 0;
+    }
+
     inicializarContador();
 
     bool salirPrograma = false;
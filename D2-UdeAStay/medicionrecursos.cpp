@@ -24,6 +24,14 @@ void incrementarIteracion() {
     contadorIteraciones++;
 }
 
+/**
+ * @brief Suma de una vez al contador las iteraciones de un recorrido ya hecho.
+ * @param cantidad Iteraciones a agregar.
+ */
+void agregarIteraciones(long long cantidad) {
+    contadorIteraciones += cantidad;
+}
+
 /**
  * @brief Obtiene el valor actual del contador de iteraciones.
  * @return Número total de iteraciones realizadas.
@@ -6,6 +6,7 @@ extern long long memoriaEstimacion;
 
 void inicializarContador();
 void incrementarIteracion();
+void agregarIteraciones(long long cantidad);
 long long obtenerIteraciones();
 
 void agregarMemoria(long long bytes);
@@ -16,7 +16,7 @@ const size_t MAX_CARACTERES = 1000;
  * Inicializa todos los atributos con valores predeterminados.
  * Reserva espacio en memoria para la anotación y establece su valor como cadena vacía.
  */
-Reservacion::Reservacion() :
+Reservacion::Reservacion() : indiceHuesped(-1),
     codigo(""), fecha_entrada(""), duracion_estadia(0), codigo_alojamiento(""),
     documento(""), metodo_pago(' '), fecha_pago(""), monto(0),
     anotacion(nullptr), capacidad_anotacion(0) {
@@ -42,7 +42,7 @@ Reservacion::Reservacion() :
  */
 Reservacion::Reservacion(const string& cod, const string& f_entrada, int duracion, const string& cod_aloja,
                          const string& doc_huesped, char metodo, const string& f_pago, float monto_reserva, const string& notas) :
-    codigo(cod), fecha_entrada(f_entrada), duracion_estadia(duracion), codigo_alojamiento(cod_aloja),
+    indiceHuesped(-1), codigo(cod), fecha_entrada(f_entrada), duracion_estadia(duracion), codigo_alojamiento(cod_aloja),
     documento(doc_huesped), metodo_pago(metodo), fecha_pago(f_pago), monto(monto_reserva), anotacion(nullptr), capacidad_anotacion(0) {
 
     incrementarIteracion();
@@ -56,7 +56,7 @@ Reservacion::Reservacion(const string& cod, const string& f_entrada, int duracio
  *
  * @param otro Otra instancia de Reservacion desde la cual se copiarán los datos.
  */
-Reservacion::Reservacion(const Reservacion& otro) :
+Reservacion::Reservacion(const Reservacion& otro) : indiceHuesped(otro.indiceHuesped),
     codigo(otro.codigo), fecha_entrada(otro.fecha_entrada), duracion_estadia(otro.duracion_estadia), codigo_alojamiento(otro.codigo_alojamiento),
     documento(otro.documento), metodo_pago(otro.metodo_pago), fecha_pago(otro.fecha_pago), monto(otro.monto), anotacion(nullptr), capacidad_anotacion(0) {
 
@@ -86,6 +86,7 @@ Reservacion& Reservacion::operator=(const Reservacion& otro) {
         metodo_pago = otro.metodo_pago;
         fecha_pago = otro.fecha_pago;
         monto = otro.monto;
+        indiceHuesped = otro.indiceHuesped;
 
         // Copiar anotacion
         copiarAnotacion(otro.anotacion);
@@ -163,119 +164,6 @@ void Reservacion::setAnotacion(const string& nueva_anotacion) {
     anotacion[longitud] = '\0';
 }
 
-/**
- * @brief Filtra alojamientos disponibles según una fecha y duración dadas.
- *
- * @param candidatos Arreglo de alojamientos posibles.
- * @param nCandidatos Número de alojamientos en el arreglo.
- * @param fechaEntrada Fecha deseada para iniciar la estadía.
- * @param noches Número de noches a reservar.
- * @param reservaciones Arreglo de reservaciones existentes.
- * @param nReservaciones Número de reservaciones existentes.
- * @param nDisponibles Variable de salida con el número de alojamientos disponibles encontrados.
- * @return Puntero a un arreglo dinámico de alojamientos disponibles.
- */
-// Implementacion del filtro de disponibilidad
-// Alojamiento* Reservacion::filtrarDisponiblesPorFecha(Alojamiento* candidatos,
-//                                                      int nCandidatos,
-//                                                      const Fecha& fechaEntrada,
-//                                                      int noches,
-//                                                      const Reservacion* reservaciones,
-//                                                      int nReservaciones,
-//                                                      int& nDisponibles) {
-
-//     incrementarIteracion();
-//     agregarMemoria(sizeof(Alojamiento*) + sizeof(int)*2);
-
-//     Alojamiento* disponibles = new Alojamiento[nCandidatos];
-//     nDisponibles = 0;
-
-//     for (int i = 0; i < nCandidatos; ++i) {
-//         incrementarIteracion();
-//         bool estaDisponible = true;
-//         agregarMemoria(sizeof(bool));
-
-//         // Verificar conflictos con reservaciones existentes
-//         for (int j = 0; j < nReservaciones && estaDisponible; ++j) {
-//             incrementarIteracion();
-//             if (reservaciones[j].getCodigoAlojamiento() == candidatos[i].getCodigo()) {
-//                 incrementarIteracion();
-//                 Fecha fechaReservada(reservaciones[j].getFechaEntrada());
-//                 agregarMemoria(sizeof(Fecha));
-//                 if (hayConflictoFechas(fechaEntrada, noches,
-//                                        fechaReservada, reservaciones[j].getDuracion())) {
-//                     estaDisponible = false;
-//                 }
-//             }
-//         }
-
-//         if (estaDisponible) {
-//             incrementarIteracion();
-//             disponibles[nDisponibles++] = candidatos[i];
-//         }
-//     }
-
-//     return disponibles;
-// }
-
-Alojamiento* Reservacion::filtrarDisponiblesPorFecha(Alojamiento* candidatos,
-                                                     int nCandidatos,
-                                                     const Fecha& fechaEntrada,
-                                                     int noches,
-                                                     const Reservacion* reservaciones,
-                                                     int nReservaciones,
-                                                     int& nDisponibles) {
-
-    incrementarIteracion();
-    agregarMemoria(sizeof(Alojamiento*) + sizeof(int)*2);
-    Alojamiento* disponibles = new Alojamiento[nCandidatos];
-    agregarMemoria(sizeof(Alojamiento) * nCandidatos);
-    nDisponibles = 0;
-
-    cout << "\n=== DEBUG: Filtrado por fecha ===" << endl;
-    cout << "Fecha buscada: " << fechaEntrada.toString() << " por " << noches << " noches" << endl;
-    cout << "Total reservaciones existentes: " << nReservaciones << endl;
-
-    for (int i = 0; i < nCandidatos; ++i) {
-        incrementarIteracion();
-        cout << "\nEvaluando alojamiento: " << candidatos[i].getCodigo() << endl;
-        bool estaDisponible = true;
-        agregarMemoria(sizeof(bool));
-
-        for (int j = 0; j < nReservaciones && estaDisponible; ++j) {
-            incrementarIteracion();
-            if (reservaciones[j].getCodigoAlojamiento() == candidatos[i].getCodigo()) {
-                incrementarIteracion();
-                Fecha fechaReservada(reservaciones[j].getFechaEntrada());
-                agregarMemoria(sizeof(Fecha));
-                cout << "Comparando con reserva existente: " << reservaciones[j].getCodigo() << endl;
-                cout << "Fecha reservada: " << fechaReservada.toString() << " por "
-                     << reservaciones[j].getDuracion() << " noches" << endl;
-
-                if (hayConflictoFechas(fechaEntrada, noches,
-                    fechaReservada, reservaciones[j].getDuracion())) {
-                    estaDisponible = false;
-                    cout << "CONFLICTO ENCONTRADO" << endl;
-                }
-            }
-        }
-
-        if (estaDisponible) {
-            incrementarIteracion();
-            disponibles[nDisponibles++] = candidatos[i];
-            cout << "ALOJAMIENTO DISPONIBLE" << endl;
-        } else {
-            incrementarIteracion();
-            cout << "ALOJAMIENTO NO DISPONIBLE" << endl;
-        }
-
-        agregarMemoria(-static_cast<long long>(sizeof(bool)));
-    }
-
-    cout << "Total disponibles: " << nDisponibles << endl;
-    return disponibles;
-}
-
 /**
  * @brief Determina si hay conflicto entre dos rangos de fechas de entrada y duración.
  *
@@ -403,23 +291,21 @@ void Reservacion::mostrarDetalle(int numero, bool esParaAnfitrion, Sistema* sist
 /**
  * @brief Obtiene el nombre del huésped asociado a la reservación.
  *
- * Busca dentro del sistema el huésped cuyo documento coincida con el de esta reservación.
- * También registra el uso de memoria y el número de iteraciones para efectos de análisis de recursos.
+ * Usa el índice del huésped resuelto al cargar o registrar la reservación; si no está
+ * resuelto, lo consulta en el índice de huéspedes del sistema. En ambos casos el costo
+ * es O(1), sin recorrer el arreglo de huéspedes.
  *
  * @param sistema Puntero al sistema que contiene el arreglo de huéspedes y su cantidad.
  * @return Nombre del huésped como string si se encuentra; "No encontrado" en caso contrario.
  */
 string Reservacion::obtenerNombreHuesped(Sistema* sistema) const {
     incrementarIteracion();
-    agregarMemoria(sizeof(Huesped*) + sizeof(int));
     const Huesped* huespedes = sistema->getHuespedes();
     int totalHuespedes = sistema->getNumHuespedes();
 
-    for (int i = 0; i < totalHuespedes; i++) {
-        incrementarIteracion();
-        if (huespedes[i].getDocumento() == this->getDocumento()) {
-            return huespedes[i].getNombre();
-        }
+    int indice = indiceHuesped;
+    if (indice < 0 || indice >= totalHuespedes || huespedes[indice].getDocumento() != documento) {
+        indice = sistema->buscarIndiceHuesped(documento);
     }
-    return "No encontrado";
+    return (indice >= 0) ? huespedes[indice].getNombre() : "No encontrado";
 }
@@ -14,6 +14,7 @@ class Reservacion {
 private:
 
     Huesped* huesped;
+    int indiceHuesped;
 
     string codigo;
     string fecha_entrada;
@@ -62,24 +63,16 @@ public:
     char getMetodoPago() const { return metodo_pago; }
     const string& getFechaPago() const { return fecha_pago; }
     float getMonto() const { return monto; }
+    int getIndiceHuesped() const { return indiceHuesped; }
     string getAnotacion() const;
 
     // Metodos para modificar
     void setAnotacion(const string& nueva_anotacion);
+    void setIndiceHuesped(int indice) { indiceHuesped = indice; }
 
     void reservarEspacio(size_t nueva_capacidad);
     void copiarAnotacion(const char* nueva_anotacion);
 
-    static Alojamiento* filtrarDisponiblesPorFecha(
-        Alojamiento* candidatos,
-        int nCandidatos,
-        const Fecha& fechaEntrada,
-        int noches,
-        const Reservacion* reservaciones,
-        int nReservaciones,
-        int& nDisponibles
-        );
-
     // Validar si hay conflicto de fechas
     static bool hayConflictoFechas(const Fecha& fechaEntrada1, int noches1,
                                    const Fecha& fechaEntrada2, int noches2);
@@ -0,0 +1,323 @@
+#include "resumenpagos.h"
+#include "medicionrecursos.h"
+
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+using namespace std;
+
+// Filas minimas que justifican un hilo adicional en la reconstruccion
+const int MIN_FILAS_POR_HILO = 4096;
+
+// Dias que se reservan con el primer pago registrado
+const int DIAS_INICIALES_RESUMEN = 64;
+
+// Departamentos que se reservan con el primero registrado
+const int CAPACIDAD_INICIAL_DEPARTAMENTOS = 8;
+
+/**
+ * @brief Constructor de la clase ResumenPagos.
+ *
+ * El resumen empieza vacío; los días y los departamentos se reservan a medida que llegan pagos.
+ */
+ResumenPagos::ResumenPagos() : departamentos(nullptr), numDepartamentos(0), capacidadDepartamentos(0),
+    diaBase(0), numDias(0), montos(nullptr), cantidades(nullptr) {}
+
+/**
+ * @brief Destructor de la clase ResumenPagos.
+ */
+ResumenPagos::~ResumenPagos() {
+    limpiar();
+}
+
+/**
+ * @brief Posición de una celda en los arreglos de totales.
+ *
+ * @param dia Día, contado desde la fecha base (dentro del rango cubierto).
+ * @param departamento Id del departamento.
+ * @param metodo Índice del método de pago (ver `indiceMetodo`).
+ * @return Posición de la celda.
+ */
+int ResumenPagos::celda(int dia, int departamento, int metodo) const {
+    return ((dia - diaBase) * capacidadDepartamentos + departamento) * NUM_METODOS_PAGO + metodo;
+}
+
+/**
+ * @brief Cambia el rango de días cubierto o la capacidad de departamentos, conservando los totales.
+ *
+ * @param nuevoDiaBase Primer día del nuevo rango.
+ * @param nuevoNumDias Días del nuevo rango (debe contener al rango actual).
+ * @param nuevaCapacidadDepartamentos Departamentos por día (no menor que la actual).
+ */
+void ResumenPagos::redimensionar(int nuevoDiaBase, int nuevoNumDias, int nuevaCapacidadDepartamentos) {
+    int nuevasCeldas = nuevoNumDias * nuevaCapacidadDepartamentos * NUM_METODOS_PAGO;
+    long long* nuevosMontos = new long long[nuevasCeldas]();
+    int* nuevasCantidades = new int[nuevasCeldas]();
+    agregarMemoria((sizeof(long long) + sizeof(int)) * nuevasCeldas);
+
+    for (int d = 0; d < numDias; ++d) {
+        for (int dep = 0; dep < numDepartamentos; ++dep) {
+            incrementarIteracion();
+            int origen = celda(diaBase + d, dep, 0);
+            int destino = ((diaBase + d - nuevoDiaBase) * nuevaCapacidadDepartamentos + dep) * NUM_METODOS_PAGO;
+            for (int m = 0; m < NUM_METODOS_PAGO; ++m) {
+                nuevosMontos[destino + m] = montos[origen + m];
+                nuevasCantidades[destino + m] = cantidades[origen + m];
+            }
+        }
+    }
+
+    int celdasActuales = numDias * capacidadDepartamentos * NUM_METODOS_PAGO;
+    delete[] montos;
+    delete[] cantidades;
+    agregarMemoria(-static_cast<long long>((sizeof(long long) + sizeof(int)) * celdasActuales));
+
+    montos = nuevosMontos;
+    cantidades = nuevasCantidades;
+    diaBase = nuevoDiaBase;
+    numDias = nuevoNumDias;
+    capacidadDepartamentos = nuevaCapacidadDepartamentos;
+}
+
+/**
+ * @brief Amplía el rango de días cubierto para que incluya un día.
+ *
+ * El rango crece al menos al doble hacia el lado del día pedido, así una secuencia de pagos
+ * en días nuevos cuesta tiempo constante amortizado por pago.
+ *
+ * @param dia Día que debe quedar cubierto.
+ */
+void ResumenPagos::asegurarDia(int dia) {
+    if (numDias == 0) {
+        redimensionar(dia, DIAS_INICIALES_RESUMEN, max(capacidadDepartamentos, 1));
+    } else if (dia < diaBase) {
+        int nuevoDiaBase = min(dia, diaBase - numDias);
+        redimensionar(nuevoDiaBase, diaBase + numDias - nuevoDiaBase, capacidadDepartamentos);
+    } else if (dia >= diaBase + numDias) {
+        redimensionar(diaBase, max(dia - diaBase + 1, numDias * 2), capacidadDepartamentos);
+    }
+}
+
+/**
+ * @brief Obtiene el id de un departamento, registrándolo si es nuevo.
+ *
+ * Los nombres se comparan normalizados (ver `IndiceHash::normalizarClave`); se conserva el
+ * nombre con el que apareció por primera vez.
+ *
+ * @param departamento Nombre del departamento.
+ * @return Id del departamento.
+ */
+int ResumenPagos::registrarDepartamento(const string& departamento) {
+    string clave = IndiceHash::normalizarClave(departamento);
+    int id = indiceDepartamentos.buscar(clave);
+    if (id >= 0) return id;
+
+    if (numDepartamentos == capacidadDepartamentos) {
+        int nuevaCapacidad = (capacidadDepartamentos == 0) ? CAPACIDAD_INICIAL_DEPARTAMENTOS
+                                                           : capacidadDepartamentos * 2;
+        string* nuevos = new string[nuevaCapacidad];
+        agregarMemoria(sizeof(string) * nuevaCapacidad);
+        for (int i = 0; i < numDepartamentos; ++i) {
+            incrementarIteracion();
+            nuevos[i] = departamentos[i];
+        }
+        delete[] departamentos;
+        agregarMemoria(-static_cast<long long>(sizeof(string) * capacidadDepartamentos));
+        departamentos = nuevos;
+
+        // Las celdas de cada dia pasan a tener espacio para los nuevos departamentos
+        if (numDias > 0) {
+            redimensionar(diaBase, numDias, nuevaCapacidad);
+        }
+        capacidadDepartamentos = nuevaCapacidad;
+    }
+
+    id = numDepartamentos++;
+    departamentos[id] = departamento;
+    indiceDepartamentos.insertar(clave, id);
+    return id;
+}
+
+/**
+ * @brief Suma (o resta) un pago en la celda de su día, departamento y método.
+ *
+ * @param departamento Id del departamento (ver `registrarDepartamento`).
+ * @param diaPago Día del pago, contado desde la fecha base.
+ * @param metodoPago Método de pago ('T' tarjeta de crédito, 'P' PSE).
+ * @param monto Monto del pago.
+ * @param signo 1 para una reservación nueva, -1 para una cancelada.
+ */
+void ResumenPagos::registrar(int departamento, int diaPago, char metodoPago, long long monto, int signo) {
+    if (departamento < 0 || departamento >= numDepartamentos) return;
+
+    asegurarDia(diaPago);
+    int pos = celda(diaPago, departamento, indiceMetodo(metodoPago));
+    montos[pos] += signo * monto;
+    cantidades[pos] += signo;
+}
+
+/**
+ * @brief Descarta todos los totales y departamentos.
+ */
+void ResumenPagos::limpiar() {
+    int celdas = numDias * capacidadDepartamentos * NUM_METODOS_PAGO;
+    delete[] montos;
+    delete[] cantidades;
+    agregarMemoria(-static_cast<long long>((sizeof(long long) + sizeof(int)) * celdas));
+
+    delete[] departamentos;
+    agregarMemoria(-static_cast<long long>(sizeof(string) * capacidadDepartamentos));
+
+    montos = nullptr;
+    cantidades = nullptr;
+    departamentos = nullptr;
+    numDias = 0;
+    diaBase = 0;
+    numDepartamentos = 0;
+    capacidadDepartamentos = 0;
+    indiceDepartamentos.limpiar();
+}
+
+/**
+ * @brief Reconstruye todos los totales a partir de columnas de pagos.
+ *
+ * Los totales actuales se descartan (los departamentos registrados se conservan). Las filas
+ * se reparten en tramos contiguos, uno por hilo; cada hilo acumula en sus propias celdas y
+ * al terminar se suman.
+ *
+ * @param diasPago Día de pago de cada fila, desde la fecha base.
+ * @param departamentosPago Id del departamento de cada fila (ver `registrarDepartamento`).
+ * @param metodosPago Índice del método de pago de cada fila (ver `indiceMetodo`).
+ * @param montosPago Monto de cada fila.
+ * @param filas Cantidad de filas.
+ * @param numHilos Hilos a usar; 0 para decidir según los núcleos disponibles y la cantidad
+ *                 de filas (al menos `MIN_FILAS_POR_HILO` por hilo).
+ */
+void ResumenPagos::reconstruir(const int* diasPago, const int* departamentosPago, const int* metodosPago,
+                               const long long* montosPago, int filas, int numHilos) {
+    int diaMin = INT_MAX;
+    int diaMax = INT_MIN;
+    for (int i = 0; i < filas; ++i) {
+        incrementarIteracion();
+        diaMin = min(diaMin, diasPago[i]);
+        diaMax = max(diaMax, diasPago[i]);
+    }
+
+    // Celdas nuevas en cero, justo para el rango de dias de las filas
+    int celdasActuales = numDias * capacidadDepartamentos * NUM_METODOS_PAGO;
+    delete[] montos;
+    delete[] cantidades;
+    agregarMemoria(-static_cast<long long>((sizeof(long long) + sizeof(int)) * celdasActuales));
+    montos = nullptr;
+    cantidades = nullptr;
+    numDias = 0;
+    if (filas == 0) return;
+    redimensionar(diaMin, diaMax - diaMin + 1, max(capacidadDepartamentos, 1));
+
+    int celdas = numDias * capacidadDepartamentos * NUM_METODOS_PAGO;
+    if (numHilos <= 0) {
+        numHilos = max(1, static_cast<int>(thread::hardware_concurrency()));
+    }
+    numHilos = max(1, min(numHilos, filas / MIN_FILAS_POR_HILO));
+
+    // Cada hilo acumula su tramo en sus propias celdas (el primero, directo en el resumen)
+    long long* montosHilos = (numHilos > 1) ? new long long[static_cast<size_t>(celdas) * (numHilos - 1)]() : nullptr;
+    int* cantidadesHilos = (numHilos > 1) ? new int[static_cast<size_t>(celdas) * (numHilos - 1)]() : nullptr;
+    agregarMemoria((sizeof(long long) + sizeof(int)) * celdas * (numHilos - 1));
+
+    auto acumular = [=](int desde, int hasta, long long* montosDestino, int* cantidadesDestino) {
+        for (int i = desde; i < hasta; ++i) {
+            if (departamentosPago[i] < 0 || departamentosPago[i] >= numDepartamentos) continue;
+            int pos = celda(diasPago[i], departamentosPago[i], metodosPago[i]);
+            montosDestino[pos] += montosPago[i];
+            cantidadesDestino[pos]++;
+        }
+    };
+
+    int filasPorHilo = (filas + numHilos - 1) / numHilos;
+    thread* hilos = new thread[numHilos];
+    for (int h = 1; h < numHilos; ++h) {
+        int desde = min(h * filasPorHilo, filas);
+        int hasta = min(desde + filasPorHilo, filas);
+        hilos[h] = thread(acumular, desde, hasta, montosHilos + static_cast<size_t>(celdas) * (h - 1),
+                          cantidadesHilos + static_cast<size_t>(celdas) * (h - 1));
+    }
+    acumular(0, min(filasPorHilo, filas), montos, cantidades);
+    for (int h = 1; h < numHilos; ++h) {
+        hilos[h].join();
+    }
+
+    for (int h = 1; h < numHilos; ++h) {
+        const long long* montosHilo = montosHilos + static_cast<size_t>(celdas) * (h - 1);
+        const int* cantidadesHilo = cantidadesHilos + static_cast<size_t>(celdas) * (h - 1);
+        for (int c = 0; c < celdas; ++c) {
+            montos[c] += montosHilo[c];
+            cantidades[c] += cantidadesHilo[c];
+        }
+    }
+
+    delete[] hilos;
+    delete[] montosHilos;
+    delete[] cantidadesHilos;
+    agregarMemoria(-static_cast<long long>((sizeof(long long) + sizeof(int)) * celdas * (numHilos - 1)));
+
+    // Los hilos no tocan los contadores globales: el recorrido se registra una vez, aqui
+    agregarIteraciones(filas);
+}
+
+/**
+ * @brief Suma los pagos de un rango de días, opcionalmente de un departamento y un método.
+ *
+ * Recorre solo las celdas de los días del rango (y de los departamentos y métodos pedidos).
+ *
+ * @param diaDesde Primer día del rango, desde la fecha base.
+ * @param diaHasta Último día del rango (inclusive).
+ * @param departamento Id del departamento, o -1 para todos.
+ * @param metodo Índice del método de pago (ver `indiceMetodo`), o -1 para todos.
+ * @param cantidad [out] Cantidad de pagos sumados.
+ * @return Suma de los montos.
+ */
+long long ResumenPagos::consultar(int diaDesde, int diaHasta, int departamento, int metodo, int& cantidad) const {
+    cantidad = 0;
+    long long total = 0;
+    if (numDias == 0 || departamento >= numDepartamentos || metodo >= NUM_METODOS_PAGO) return 0;
+
+    int primerDia = max(diaDesde, diaBase);
+    int ultimoDia = min(diaHasta, diaBase + numDias - 1);
+    int depInicio = (departamento < 0) ? 0 : departamento;
+    int depFin = (departamento < 0) ? numDepartamentos : departamento + 1;
+    int metInicio = (metodo < 0) ? 0 : metodo;
+    int metFin = (metodo < 0) ? NUM_METODOS_PAGO : metodo + 1;
+
+    for (int dia = primerDia; dia <= ultimoDia; ++dia) {
+        incrementarIteracion();
+        for (int dep = depInicio; dep < depFin; ++dep) {
+            int pos = celda(dia, dep, 0);
+            for (int m = metInicio; m < metFin; ++m) {
+                total += montos[pos + m];
+                cantidad += cantidades[pos + m];
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Índice de un método de pago en las celdas del resumen.
+ *
+ * @param metodoPago Método de pago de la reservación.
+ * @return 0 para tarjeta de crédito ('T'), 1 para PSE ('P') y 2 para cualquier otro valor.
+ */
+int ResumenPagos::indiceMetodo(char metodoPago) {
+    switch (metodoPago) {
+    case 'T':
+    case 't':
+        return 0;
+    case 'P':
+    case 'p':
+        return 1;
+    default:
+        return 2;
+    }
+}
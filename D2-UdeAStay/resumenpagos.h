@@ -0,0 +1,66 @@
+#ifndef RESUMENPAGOS_H
+#define RESUMENPAGOS_H
+
+#include "indicehash.h"
+
+#include <string>
+
+using namespace std;
+
+// Totales diarios de pagos por departamento y metodo de pago.
+// Las celdas forman un arreglo denso [dia][departamento][metodo], asi un reporte sobre un
+// rango de fechas recorre solo los dias del rango.
+class ResumenPagos {
+private:
+
+    IndiceHash indiceDepartamentos;     // departamento normalizado -> id
+    string* departamentos;              // Nombre de cada departamento, por id
+    int numDepartamentos;
+    int capacidadDepartamentos;
+
+    int diaBase;                        // Primer dia cubierto, desde la fecha base
+    int numDias;                        // Dias cubiertos: [diaBase, diaBase + numDias)
+    long long* montos;                  // Suma de montos de cada celda
+    int* cantidades;                    // Pagos de cada celda (una cancelacion resta uno)
+
+    int celda(int dia, int departamento, int metodo) const;
+    void redimensionar(int nuevoDiaBase, int nuevoNumDias, int nuevaCapacidadDepartamentos);
+    void asegurarDia(int dia);
+
+public:
+
+    // Metodos de pago: tarjeta de credito, PSE y cualquier otro valor
+    static const int NUM_METODOS_PAGO = 3;
+
+    // Constructor
+    ResumenPagos();
+
+    // Destructor
+    ~ResumenPagos();
+
+    // No copiable: es dueno de sus arreglos
+    ResumenPagos(const ResumenPagos&) = delete;
+    ResumenPagos& operator=(const ResumenPagos&) = delete;
+
+    // Getters
+    int getNumDepartamentos() const { return numDepartamentos; }
+    const string& getDepartamento(int id) const { return departamentos[id]; }
+    int getDiaBase() const { return diaBase; }
+    int getNumDias() const { return numDias; }
+
+    // Mantenimiento incremental
+    int registrarDepartamento(const string& departamento);
+    void registrar(int departamento, int diaPago, char metodoPago, long long monto, int signo);
+    void limpiar();
+
+    // Reconstruccion en paralelo a partir de columnas de pagos
+    void reconstruir(const int* diasPago, const int* departamentosPago, const int* metodosPago,
+                     const long long* montosPago, int filas, int numHilos = 0);
+
+    // Consultas (departamento o metodo -1: todos)
+    long long consultar(int diaDesde, int diaHasta, int departamento, int metodo, int& cantidad) const;
+
+    static int indiceMetodo(char metodoPago);
+};
+
+#endif // RESUMENPAGOS_H
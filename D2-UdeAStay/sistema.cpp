@@ -2,14 +2,39 @@
 #include "anfitrion.h"
 #include "huesped.h"
 #include "gestionarchivos.h"
+#include "catalogoalojamientos.h"
+#include "agendaalojamientos.h"
+#include "analiticaocupacion.h"
+#include "cachebusquedas.h"
+#include "diccionarioamenidades.h"
+#include "resumenpagos.h"
+#include "disponibilidadmunicipios.h"
 #include "medicionrecursos.h"
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
+// Consultas de disponibilidad recientes que se conservan para repetirlas sin filtrar
+const int CAPACIDAD_CACHE_BUSQUEDAS = 64;
+
+// Formato de los cortes historicos nuevos: texto con indice disperso (true: grupos columnares,
+// que los reportes leen por columnas). Los dos formatos se leen siempre, aunque se cambie
+const bool HISTORICO_COLUMNAR = false;
+
+// Dias antes del mes en que se buscan, en el historico, estadias que aun ocupan noches del calendario
+const int DIAS_ATRAS_CALENDARIO_HISTORICO = 366;
+
+// Noches, desde hoy, que cubren los contadores de disponibilidad por municipio
+const int DIAS_HORIZONTE_DISPONIBILIDAD = 366;
+
 /**
  * @brief Constructor por defecto de la clase Sistema.
  *
@@ -18,13 +43,24 @@ using namespace std;
  */
 Sistema::Sistema() : documento(""), anfitriones(nullptr), huespedes(nullptr),
     alojamientos(nullptr), reservaciones(nullptr), numAnfitriones(0),
-    numHuespedes(0), numAlojamientos(0), numReservaciones(0), gestionArchivos(new GestionArchivos()) {
+    numHuespedes(0), numAlojamientos(0), numReservaciones(0), gestionArchivos(new GestionArchivos()),
+    catalogo(new CatalogoAlojamientos()), agenda(new AgendaAlojamientos()),
+    cacheBusquedas(new CacheBusquedas(CAPACIDAD_CACHE_BUSQUEDAS)), resumenPagos(new ResumenPagos()),
+    disponibilidad(new DisponibilidadMunicipios()), bufferBusqueda(nullptr),
+    inicioAlojamientosAnfitrion(nullptr), alojamientosPorAnfitrion(nullptr), duracionMaximaReservacion(0),
+    diaUltimoCorteAutomatico(-1) {
 
     incrementarIteracion();
     agregarMemoria(sizeof(Sistema));
     agregarMemoria(sizeof(GestionArchivos));
+    agregarMemoria(sizeof(CatalogoAlojamientos));
+    agregarMemoria(sizeof(AgendaAlojamientos));
+    agregarMemoria(sizeof(CacheBusquedas));
+    agregarMemoria(sizeof(ResumenPagos));
+    agregarMemoria(sizeof(DisponibilidadMunicipios));
 
     ultimoIdReservacion = gestionArchivos->cargarUltimoIdReservacion();
+    gestionArchivos->setHistoricoColumnar(HISTORICO_COLUMNAR);
     incrementarIteracion();
 }
 
@@ -50,6 +86,31 @@ Sistema::~Sistema() {
     delete gestionArchivos;
     agregarMemoria(-static_cast<long long>(sizeof(GestionArchivos)));
 
+    delete catalogo;
+    agregarMemoria(-static_cast<long long>(sizeof(CatalogoAlojamientos)));
+
+    delete agenda;
+    agregarMemoria(-static_cast<long long>(sizeof(AgendaAlojamientos)));
+
+    delete cacheBusquedas;
+    agregarMemoria(-static_cast<long long>(sizeof(CacheBusquedas)));
+
+    delete resumenPagos;
+    agregarMemoria(-static_cast<long long>(sizeof(ResumenPagos)));
+
+    delete disponibilidad;
+    agregarMemoria(-static_cast<long long>(sizeof(DisponibilidadMunicipios)));
+
+    if (bufferBusqueda) {
+        agregarMemoria(-static_cast<long long>(sizeof(int) * numAlojamientos));
+        delete[] bufferBusqueda;
+    }
+    if (inicioAlojamientosAnfitrion) {
+        agregarMemoria(-static_cast<long long>(sizeof(int) * (numAnfitriones + 1 + numAlojamientos)));
+        delete[] inicioAlojamientosAnfitrion;
+        delete[] alojamientosPorAnfitrion;
+    }
+
     // Liberar arreglos dinámicos
     if (anfitriones) {
         agregarMemoria(-static_cast<long long>(sizeof(Anfitrion) * numAnfitriones));
@@ -68,6 +129,9 @@ Sistema::~Sistema() {
         delete[] reservaciones;
     }
 
+    // El diccionario de amenidades solo lo usan los alojamientos del sistema
+    DiccionarioAmenidades::limpiar();
+
     numAnfitriones = numHuespedes = numAlojamientos = numReservaciones = 0;
 }
 
@@ -96,10 +160,12 @@ bool Sistema::operator==(const Sistema& otro) const {
  * - Alojamientos
  * - Reservaciones
  *
- * Esta función inicializa los punteros dinámicos y sus respectivos contadores.
+ * Esta función inicializa los punteros dinámicos y sus respectivos contadores, y luego
+ * construye los índices en memoria (ver `construirIndices`).
  */
 void Sistema::cargarDatos() {
     GestionArchivos gestor;
+    gestor.setHistoricoColumnar(HISTORICO_COLUMNAR);
 
     // Cargar anfitriones
     gestor.cargarAnfitriones(anfitriones, numAnfitriones);
@@ -112,41 +178,310 @@ void Sistema::cargarDatos() {
 
     // Cargar reservaciones
     gestor.cargarReservaciones(reservaciones, numReservaciones);
+
+    // Pasar el historico de un solo archivo (formato anterior) a segmentos mensuales
+    int migradas = gestor.migrarHistoricoUnico();
+    if (migradas > 0) {
+        cout << "[Historico] " << migradas << " reservaciones migradas a segmentos mensuales.\n";
+    }
+
+    // Construir indices y catalogo para las consultas
+    construirIndices();
+}
+
+/**
+ * @brief Construye los índices en memoria a partir de los datos cargados.
+ *
+ * - Índice hash de anfitriones por documento.
+ * - Índice hash de credenciales: documento -> usuario, donde los valores [0, numAnfitriones)
+ *   son anfitriones y los siguientes son huéspedes desplazados en numAnfitriones.
+ * - Índice hash de huéspedes por documento, con el que se resuelve una sola vez el huésped
+ *   de cada reservación cargada.
+ * - Lista de alojamientos de cada anfitrión (agrupados en un solo arreglo, con el rango
+ *   de cada anfitrión en `inicioAlojamientosAnfitrion`).
+ * - Arreglo de reservaciones ordenado por fecha de salida, índice hash de alojamientos por
+ *   código y agenda de ocupación: las reservaciones de cada alojamiento ordenadas por
+ *   fecha de entrada.
+ * - Catálogo columnar de búsqueda, cuya columna de puntuación se llena con una
+ *   consulta O(1) al índice de anfitriones por alojamiento.
+ * - Contadores de alojamientos ocupados por municipio y noche, desde hoy.
+ * - Buffer de trabajo que reutilizan todas las búsquedas de la sesión.
+ * - Resumen de pagos por día, departamento y método, con el histórico incluido.
+ */
+void Sistema::construirIndices() {
+    // 1. Anfitriones por documento (si hay documentos repetidos se conserva el primero)
+    indiceAnfitriones.limpiar();
+    indiceAnfitriones.reservar(numAnfitriones);
+    for (int i = 0; i < numAnfitriones; ++i) {
+        incrementarIteracion();
+        indiceAnfitriones.insertar(anfitriones[i].getDocumento(), i);
+    }
+
+    // 2. Credenciales de todos los usuarios. Un documento identifica a un solo usuario:
+    //    si un huesped repite el documento de un anfitrion, prevalece el anfitrion.
+    indiceUsuarios.limpiar();
+    indiceUsuarios.reservar(numAnfitriones + numHuespedes);
+    for (int i = 0; i < numAnfitriones; ++i) {
+        incrementarIteracion();
+        indiceUsuarios.insertar(anfitriones[i].getDocumento(), i);
+    }
+    for (int i = 0; i < numHuespedes; ++i) {
+        incrementarIteracion();
+        indiceUsuarios.insertar(huespedes[i].getDocumento(), numAnfitriones + i);
+    }
+
+    // 3. Huespedes por documento y resolucion del huesped de cada reservacion
+    indiceHuespedes.limpiar();
+    indiceHuespedes.reservar(numHuespedes);
+    for (int i = 0; i < numHuespedes; ++i) {
+        incrementarIteracion();
+        indiceHuespedes.insertar(huespedes[i].getDocumento(), i);
+    }
+    for (int i = 0; i < numReservaciones; ++i) {
+        incrementarIteracion();
+        reservaciones[i].setIndiceHuesped(indiceHuespedes.buscar(reservaciones[i].getDocumento()));
+    }
+
+    // 4. Alojamientos de cada anfitrion (conteo + suma de prefijos)
+    delete[] inicioAlojamientosAnfitrion;
+    delete[] alojamientosPorAnfitrion;
+    inicioAlojamientosAnfitrion = new int[numAnfitriones + 1]();
+    alojamientosPorAnfitrion = new int[numAlojamientos > 0 ? numAlojamientos : 1];
+    agregarMemoria(sizeof(int) * (numAnfitriones + 1 + numAlojamientos));
+
+    int* anfitrionDeAlojamiento = new int[numAlojamientos > 0 ? numAlojamientos : 1];
+    agregarMemoria(sizeof(int) * numAlojamientos);
+
+    int asignados = 0;
+    for (int i = 0; i < numAlojamientos; ++i) {
+        incrementarIteracion();
+        anfitrionDeAlojamiento[i] = indiceAnfitriones.buscar(alojamientos[i].getDocumentoAnfitrion());
+        if (anfitrionDeAlojamiento[i] >= 0) {
+            inicioAlojamientosAnfitrion[anfitrionDeAlojamiento[i] + 1]++;
+            asignados++;
+        }
+    }
+    for (int i = 0; i < numAnfitriones; ++i) {
+        incrementarIteracion();
+        inicioAlojamientosAnfitrion[i + 1] += inicioAlojamientosAnfitrion[i];
+    }
+    // Se llena de atras hacia adelante: la posicion a + 1 sirve de cursor que baja
+    // desde el fin hasta el inicio del rango del anfitrion a
+    for (int i = numAlojamientos - 1; i >= 0; --i) {
+        incrementarIteracion();
+        int anfitrion = anfitrionDeAlojamiento[i];
+        if (anfitrion >= 0) {
+            alojamientosPorAnfitrion[--inicioAlojamientosAnfitrion[anfitrion + 1]] = i;
+        }
+    }
+    // Cada cursor quedo en el inicio de su anfitrion: se desplazan una posicion
+    for (int i = 0; i < numAnfitriones; ++i) {
+        inicioAlojamientosAnfitrion[i] = inicioAlojamientosAnfitrion[i + 1];
+    }
+    inicioAlojamientosAnfitrion[numAnfitriones] = asignados;
+
+    delete[] anfitrionDeAlojamiento;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * numAlojamientos));
+
+    // 5. Reservaciones por dia de salida, alojamientos por codigo y agenda de ocupacion
+    //    (reservaciones de cada alojamiento por fecha de entrada)
+    ordenarReservacionesPorSalida();
+    indiceAlojamientos.limpiar();
+    indiceAlojamientos.reservar(numAlojamientos);
+    for (int i = 0; i < numAlojamientos; ++i) {
+        incrementarIteracion();
+        indiceAlojamientos.insertar(alojamientos[i].getCodigo(), i);
+    }
+    agenda->construir(numAlojamientos, reservaciones, numReservaciones, indiceAlojamientos);
+
+    // 6. Catalogo columnar para los filtros de busqueda
+    catalogo->construir(alojamientos, numAlojamientos, anfitriones, indiceAnfitriones);
+    construirDisponibilidad();
+
+    // 7. Buffer de resultados reutilizado por todas las busquedas de la sesion
+    delete[] bufferBusqueda;
+    bufferBusqueda = new int[numAlojamientos > 0 ? numAlojamientos : 1];
+    agregarMemoria(sizeof(int) * numAlojamientos);
+
+    // 8. Resumen de pagos con las reservaciones activas y las historicas; desde aqui se
+    //    mantiene con cada reservacion nueva o cancelada
+    reconstruirResumenPagos();
+
+    // Los resultados guardados se refieren a los datos anteriores
+    cacheBusquedas->limpiar();
+}
+
+/**
+ * @brief Calcula el día de salida de una reservación (el día siguiente a su última noche).
+ *
+ * @param indice Posición de la reservación en el arreglo del sistema.
+ * @return Días desde la fecha base hasta el día de salida.
+ */
+int Sistema::diaSalidaReservacion(int indice) const {
+    return Fecha(reservaciones[indice].getFechaEntrada()).aDiasDesdeFechaBase() +
+           reservaciones[indice].getDuracion();
+}
+
+/**
+ * @brief Cuenta las reservaciones que salen a más tardar en un día dado.
+ *
+ * Como el arreglo está ordenado por día de salida, son un prefijo y se cuentan con una
+ * búsqueda binaria. O(log n).
+ *
+ * @param dia Día límite (días desde la fecha base).
+ * @return Cantidad de reservaciones con día de salida menor o igual a `dia`.
+ */
+int Sistema::contarReservacionesQueSalenHasta(int dia) const {
+    int bajo = 0;
+    int alto = numReservaciones;
+    while (bajo < alto) {
+        incrementarIteracion();
+        int medio = (bajo + alto) / 2;
+        if (diaSalidaReservacion(medio) <= dia) {
+            bajo = medio + 1;
+        } else {
+            alto = medio;
+        }
+    }
+    return bajo;
+}
+
+/**
+ * @brief Ordena las reservaciones cargadas por día de salida.
+ *
+ * Se ordena una permutación de índices con los días de salida ya calculados y luego se
+ * copian las reservaciones una sola vez en el nuevo orden (estable: a igual salida se
+ * conserva el orden del archivo). También se calcula la duración máxima, que acota qué
+ * reservaciones pueden estar en curso.
+ */
+void Sistema::ordenarReservacionesPorSalida() {
+    duracionMaximaReservacion = 0;
+    if (numReservaciones == 0) return;
+
+    int* salidas = new int[numReservaciones];
+    int* orden = new int[numReservaciones];
+    agregarMemoria(sizeof(int) * 2 * numReservaciones);
+
+    bool ordenadas = true;
+    for (int i = 0; i < numReservaciones; ++i) {
+        incrementarIteracion();
+        salidas[i] = diaSalidaReservacion(i);
+        orden[i] = i;
+        ordenadas = ordenadas && (i == 0 || salidas[i - 1] <= salidas[i]);
+        duracionMaximaReservacion = max(duracionMaximaReservacion, reservaciones[i].getDuracion());
+    }
+
+    if (!ordenadas) {
+        stable_sort(orden, orden + numReservaciones, [salidas](int a, int b) {
+            return salidas[a] < salidas[b];
+        });
+
+        Reservacion* ordenado = new Reservacion[numReservaciones];
+        agregarMemoria(sizeof(Reservacion) * numReservaciones);
+        for (int i = 0; i < numReservaciones; ++i) {
+            incrementarIteracion();
+            ordenado[i] = reservaciones[orden[i]];
+        }
+
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * numReservaciones));
+        delete[] reservaciones;
+        reservaciones = ordenado;
+    }
+
+    delete[] salidas;
+    delete[] orden;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * numReservaciones));
+}
+
+/**
+ * @brief Busca la posición de un anfitrión en el arreglo de anfitriones por su documento.
+ *
+ * @param documentoAnfitrion Documento del anfitrión.
+ * @return Índice del anfitrión en `getAnfitriones()`, o -1 si no existe.
+ */
+int Sistema::buscarIndiceAnfitrion(const string& documentoAnfitrion) const {
+    return indiceAnfitriones.buscar(documentoAnfitrion);
+}
+
+/**
+ * @brief Busca la posición de un alojamiento en el arreglo de alojamientos por su código.
+ *
+ * @param codigo Código del alojamiento.
+ * @return Índice del alojamiento en `getAlojamientos()`, o -1 si no existe.
+ */
+int Sistema::buscarIndiceAlojamiento(const string& codigo) const {
+    return indiceAlojamientos.buscar(codigo);
+}
+
+/**
+ * @brief Busca un alojamiento por su código.
+ *
+ * @param codigo Código del alojamiento.
+ * @return Puntero al alojamiento dentro de `getAlojamientos()`, o nullptr si no existe.
+ */
+Alojamiento* Sistema::buscarAlojamientoPorCodigo(const string& codigo) {
+    int indice = indiceAlojamientos.buscar(codigo);
+    return (indice >= 0) ? &alojamientos[indice] : nullptr;
+}
+
+/**
+ * @brief Busca la posición de un huésped en el arreglo de huéspedes por su documento.
+ *
+ * @param documentoHuesped Documento del huésped.
+ * @return Índice del huésped en `getHuespedes()`, o -1 si no existe.
+ */
+int Sistema::buscarIndiceHuesped(const string& documentoHuesped) const {
+    return indiceHuespedes.buscar(documentoHuesped);
+}
+
+/**
+ * @brief Obtiene los alojamientos que administra un anfitrión.
+ *
+ * @param indiceAnfitrion Índice del anfitrión en `getAnfitriones()`.
+ * @param cantidad [out] Número de alojamientos del anfitrión.
+ * @return Índices de sus alojamientos dentro de `getAlojamientos()` (memoria del sistema, no liberar).
+ */
+const int* Sistema::getAlojamientosDeAnfitrion(int indiceAnfitrion, int& cantidad) const {
+    if (indiceAnfitrion < 0 || indiceAnfitrion >= numAnfitriones) {
+        cantidad = 0;
+        return nullptr;
+    }
+    cantidad = inicioAlojamientosAnfitrion[indiceAnfitrion + 1] - inicioAlojamientosAnfitrion[indiceAnfitrion];
+    return alojamientosPorAnfitrion + inicioAlojamientosAnfitrion[indiceAnfitrion];
 }
 
 /**
  * @brief Autentica un usuario en el sistema verificando su documento y clave.
  *
- * Busca primero en la lista de anfitriones y luego en la de huéspedes.
- * Si se encuentra una coincidencia, se establece el tipo de rol correspondiente
- * ("Anfitrion" o "Huesped").
+ * Consulta el índice de usuarios por documento (una búsqueda O(1)) y compara la clave
+ * del usuario encontrado. Si coincide, se establece el tipo de rol correspondiente
+ * ("Anfitrion" o "Huesped") y la posición del usuario en su arreglo.
  *
  * @param doc Documento de identidad del usuario.
  * @param clave Clave de acceso proporcionada por el usuario.
  * @param tipoRol [out] Rol del usuario autenticado ("Anfitrion" o "Huesped").
+ * @param indiceUsuario [out] Índice del usuario en `getAnfitriones()` o `getHuespedes()` según su rol.
  * @return true Si se autenticó correctamente.
  * @return false Si no se encontró coincidencia con las credenciales proporcionadas.
  */
-bool Sistema::autenticarUsuario(const string& doc, const string& clave, string& tipoRol) {
-    //Buscar en anfitriones
-    for (int i = 0; i < numAnfitriones; i++) {
-        incrementarIteracion();
-        if (anfitriones[i].getDocumento() == doc && anfitriones[i].getClave() == clave) {
-            tipoRol = "Anfitrion";
-            return true;
-        }
+bool Sistema::autenticarUsuario(const string& doc, const string& clave, string& tipoRol, int& indiceUsuario) {
+    int usuario = indiceUsuarios.buscar(doc);
+    if (usuario < 0) {
+        return false; // No encontrado
     }
 
-    // Buscar en huespedes
-    for (int i = 0; i < numHuespedes; i++) {
-        incrementarIteracion();
-        if (huespedes[i].getDocumento() == doc && huespedes[i].getClave() == clave) {
-            tipoRol = "Huesped";
-            return true;
-        }
+    incrementarIteracion();
+    if (usuario < numAnfitriones) {
+        if (anfitriones[usuario].getClave() != clave) return false;
+        tipoRol = "Anfitrion";
+        indiceUsuario = usuario;
+    } else {
+        usuario -= numAnfitriones;
+        if (huespedes[usuario].getClave() != clave) return false;
+        tipoRol = "Huesped";
+        indiceUsuario = usuario;
     }
-
-    return false; // No encontrado
+    return true;
 }
 
 // bool Sistema::autenticarUsuario(const string& doc, const string& clave, string& tipoRol) {
@@ -188,7 +523,8 @@ bool Sistema::autenticarUsuario(const string& doc, const string& clave, string&
  * @brief Inicia sesión para un usuario autenticado y redirige al menú correspondiente.
  *
  * Llama a `autenticarUsuario` para validar las credenciales. Si la autenticación es exitosa,
- * guarda el documento del usuario en el sistema y muestra el menú adecuado según el rol:
+ * guarda el documento del usuario en el sistema y, con el índice que devuelve la
+ * autenticación (sin volver a buscar), muestra el menú adecuado según el rol:
  * - Menú del anfitrión si el usuario es un anfitrión.
  * - Menú del huésped si el usuario es un huésped.
  *
@@ -199,29 +535,18 @@ bool Sistema::autenticarUsuario(const string& doc, const string& clave, string&
  */
 bool Sistema::iniciarSesion(const string &documento, const string &clave) {
     string tipoRol;
+    int indiceUsuario = -1;
 
-    if (autenticarUsuario(documento, clave, tipoRol)) {
+    if (autenticarUsuario(documento, clave, tipoRol, indiceUsuario)) {
         cout << "\nInicio de sesion exitosa su ROL es: " << tipoRol << endl;
         this->documento = documento;
 
         if (tipoRol == "Anfitrion") {
-            for (int i = 0; i < numAnfitriones; i++) {
-                incrementarIteracion();
-                if (anfitriones[i].getDocumento() == documento) {
-                    cout << "\nBienvenido Anfitrion: " << anfitriones[i].getCodigo() << endl;
-                    mostrarMenuAnfitrion(anfitriones[i]);
-                    break;
-                }
-            }
+            cout << "\nBienvenido Anfitrion: " << anfitriones[indiceUsuario].getCodigo() << endl;
+            mostrarMenuAnfitrion(anfitriones[indiceUsuario]);
         } else if (tipoRol == "Huesped") {
-            for (int i = 0; i < numHuespedes; i++) {
-                incrementarIteracion();
-                if (huespedes[i].getDocumento() == documento) {
-                    cout << "\nBienvenido Huesped: " << huespedes[i].getNombre() << endl;
-                    mostrarMenuHuesped(huespedes[i]);
-                    break;
-                }
-            }
+            cout << "\nBienvenido Huesped: " << huespedes[indiceUsuario].getNombre() << endl;
+            mostrarMenuHuesped(huespedes[indiceUsuario]);
         }
         return true;
     }
@@ -236,6 +561,10 @@ bool Sistema::iniciarSesion(const string &documento, const string &clave) {
  * - Cancelar reservaciones.
  * - Actualizar el histórico de reservaciones.
  * - Cerrar sesión o salir del programa.
+ * - Ver la ocupación y los ingresos mensuales de sus alojamientos.
+ * - Ver el calendario de ocupación de un mes.
+ *
+ * Las opciones nuevas se agregan al final para no cambiar el número de las existentes.
  *
  * Cada acción se ejecuta a través de los métodos propios del objeto `Anfitrion`.
  *
@@ -246,12 +575,17 @@ void Sistema::mostrarMenuAnfitrion(Anfitrion& anfitrion) {
     bool volverLogin = false;
 
     while (!volverLogin) {
+        // Punto seguro: entre una accion y la siguiente
+        ejecutarCorteHistoricoAutomatico();
+
         cout << "\n--- MENU ANFITRION ---\n";
         cout << "1. Ver reservaciones activas\n";
         cout << "2. Cancelar reservaciones\n";
         cout << "3. Actualizar historico de las reservaciones\n";
         cout << "4. Cerrar sesion\n";
         cout << "5. Salir del programa\n";
+        cout << "6. Ver ocupacion e ingresos\n";
+        cout << "7. Ver calendario del mes\n";
         cout << "Seleccione una opcion: ";
         cin >> opcion;
 
@@ -278,6 +612,14 @@ void Sistema::mostrarMenuAnfitrion(Anfitrion& anfitrion) {
             cout << "Saliendo del programa...\n";
             exit(0);
             break;
+        case 6:
+            incrementarIteracion(); // Ocupacion e ingresos
+            anfitrion.mostrarOcupacion(this);
+            break;
+        case 7:
+            incrementarIteracion(); // Calendario del mes
+            anfitrion.mostrarCalendario(this);
+            break;
         default:
             cout << "Opcion no valida. Intente nuevamente.\n";
         }
@@ -292,6 +634,7 @@ void Sistema::mostrarMenuAnfitrion(Anfitrion& anfitrion) {
  * - Consultar sus reservaciones actuales.
  * - Cancelar una reservación.
  * - Cerrar sesión o salir del programa.
+ * - Buscar y reservar con fechas flexibles.
  *
  * Cada acción se ejecuta mediante los métodos asociados al objeto `Huesped`.
  *
@@ -302,12 +645,16 @@ void Sistema::mostrarMenuHuesped(Huesped& huesped) {
     bool volverLogin = false;
 
     while (!volverLogin) {
+        // Punto seguro: entre una accion y la siguiente
+        ejecutarCorteHistoricoAutomatico();
+
         cout << "\n--- MENU HUESPED ---\n";
         cout << "1. Buscar y reservar alojamiento\n";
         cout << "2. Ver mis reservaciones\n";
         cout << "3. Cancelar reservacion\n";
         cout << "4. Cerrar sesion\n";
         cout << "5. Salir del programa\n";
+        cout << "6. Buscar con fechas flexibles\n";
         cout << "Seleccione una opcion: ";
         cin >> opcion;
 
@@ -334,6 +681,10 @@ void Sistema::mostrarMenuHuesped(Huesped& huesped) {
             cout << "Saliendo del programa...\n";
             exit(0);
             break;
+        case 6:
+            incrementarIteracion(); // Buscar con fechas flexibles
+            huesped.ReservarConFechasFlexibles(this);
+            break;
         default:
             cout << "Opcion no valida. Intente nuevamente.\n";
         }
@@ -343,50 +694,31 @@ void Sistema::mostrarMenuHuesped(Huesped& huesped) {
 /**
  * @brief Filtra los alojamientos disponibles según criterios básicos como municipio, precio y puntuación mínima.
  *
- * Este método recorre todos los alojamientos y selecciona aquellos que cumplan con:
+ * El filtrado se hace sobre el catálogo columnar (`CatalogoAlojamientos`), que evalúa
+ * municipio, precio y puntuación sobre columnas contiguas y escribe en `seleccion` los
+ * índices de los alojamientos que cumplen. Solo se recorren los alojamientos del municipio
+ * pedido, que se compara sin distinguir mayúsculas, tildes ni espacios sobrantes:
  * - Estar en el municipio indicado.
  * - Tener un precio igual o inferior al precio máximo (si se proporciona).
  * - Tener una puntuación igual o superior a la mínima (si se proporciona).
+ * - Tener todas las amenidades indicadas (si se proporcionan).
+ *
+ * No se copia ningún `Alojamiento`: el resultado son índices dentro de `getAlojamientos()`,
+ * ordenados de menor a mayor precio por noche.
  *
  * @param municipio Municipio deseado para la búsqueda.
  * @param precioMax Precio máximo permitido. Si es negativo, no se filtra por precio.
  * @param puntuacionMin Puntuación mínima del anfitrión requerida. Si es negativa, no se filtra por puntuación.
- * @param cantidadFiltrada Parámetro de salida con la cantidad de alojamientos que cumplieron los filtros.
- * @return Puntero a un arreglo dinámico de objetos `Alojamiento` filtrados. El arreglo debe ser liberado posteriormente con `delete[]`.
+ * @param idsAmenidades Ids de las amenidades requeridas (ver `DiccionarioAmenidades`).
+ * @param numIdsAmenidades Cantidad de ids en `idsAmenidades`.
+ * @param seleccion [out] Arreglo con capacidad para `getNumAlojamientos()` índices.
+ * @return Cantidad de alojamientos que cumplieron los filtros.
  */
-Alojamiento* Sistema::filtrarAlojamientosDisponibles(
-    const string& municipio, float precioMax, float puntuacionMin, int& cantidadFiltrada
-    ) {
-    Alojamiento* resultado = new Alojamiento[numAlojamientos];
-    agregarMemoria(sizeof(Alojamiento) * numAlojamientos);
-    cantidadFiltrada = 0;
-
-    for (int i = 0; i < numAlojamientos; ++i) {
-        incrementarIteracion();
-        if (alojamientos[i].getMunicipio() != municipio)
-            continue;
-
-        if (precioMax >= 0 && alojamientos[i].getPrecio() > precioMax)
-            continue;
-
-        string docAnfitrion = alojamientos[i].getDocumentoAnfitrion();
-        float puntuacion = -1;
-
-        for (int j = 0; j < numAnfitriones; ++j) {
-            incrementarIteracion();
-            if (anfitriones[j].getDocumento() == docAnfitrion) {
-                puntuacion = anfitriones[j].getPuntuacion();
-                break;
-            }
-        }
-
-        if (puntuacionMin >= 0 && puntuacion < puntuacionMin)
-            continue;
-
-        resultado[cantidadFiltrada++] = alojamientos[i];
-    }
-
-    return resultado;
+int Sistema::filtrarAlojamientosDisponibles(const string& municipio, float precioMax,
+                                            float puntuacionMin, const int* idsAmenidades,
+                                            int numIdsAmenidades, int* seleccion) {
+    return catalogo->filtrar(catalogo->buscarIdMunicipio(municipio), precioMax, puntuacionMin,
+                             idsAmenidades, numIdsAmenidades, seleccion);
 }
 
 // Alojamiento* Sistema::filtrarAlojamientosDisponibles(
@@ -443,50 +775,356 @@ Alojamiento* Sistema::filtrarAlojamientosDisponibles(
 //     return resultado;
 // }
 
+/**
+ * @brief Deja en el buffer de búsqueda los alojamientos que cumplen los criterios que no dependen de fechas.
+ *
+ * Traduce las amenidades requeridas a ids del diccionario y llama a
+ * `filtrarAlojamientosDisponibles` (municipio, precio, puntuación y amenidades).
+ *
+ * @param municipio Municipio donde se desea realizar la reserva.
+ * @param precioMax Precio máximo por noche permitido. Si es negativo, no se filtra por precio.
+ * @param puntuacionMin Puntuación mínima del anfitrión permitida. Si es negativa, no se filtra por puntuación.
+ * @param amenidadesRequeridas Amenidades separadas por comas que deben estar todas presentes.
+ *                             Si está vacía no se filtra; si alguna no existe no hay resultados.
+ * @return Cantidad de candidatos escritos en `bufferBusqueda`, del más barato al más caro.
+ */
+int Sistema::filtrarCandidatos(const string& municipio, float precioMax, float puntuacionMin,
+                               const string& amenidadesRequeridas) {
+    // 1. Traducir las amenidades requeridas a ids del diccionario
+    int* idsAmenidades = new int[DiccionarioAmenidades::getNumAmenidades() + 1];
+    agregarMemoria(sizeof(int) * (DiccionarioAmenidades::getNumAmenidades() + 1));
+    int nAmenidades = DiccionarioAmenidades::interpretarLista(amenidadesRequeridas, idsAmenidades);
+
+    // 2. Filtrar por criterios basicos (una amenidad inexistente no tiene resultados)
+    int nFiltrados = 0;
+    if (nAmenidades >= 0) {
+        nFiltrados = filtrarAlojamientosDisponibles(
+            municipio, precioMax, puntuacionMin, idsAmenidades, nAmenidades, bufferBusqueda
+            );
+    }
+
+    agregarMemoria(-static_cast<long long>(sizeof(int) * (DiccionarioAmenidades::getNumAmenidades() + 1)));
+    delete[] idsAmenidades;
+
+    return nFiltrados;
+}
+
 /**
  * @brief Busca alojamientos disponibles que cumplan con los criterios del usuario, incluyendo disponibilidad por fechas.
  *
- * Este método realiza dos fases de filtrado:
- * 1. Llama a `filtrarAlojamientosDisponibles` para filtrar por municipio, precio y puntuación.
- * 2. Llama a `Reservacion::filtrarDisponiblesPorFecha` para verificar disponibilidad real en las fechas deseadas.
+ * Este método realiza dos fases de filtrado sobre el buffer de trabajo de la sesión:
+ * 1. Llama a `filtrarCandidatos` para filtrar por municipio, precio, puntuación
+ *    y amenidades requeridas (ver `CatalogoAlojamientos::filtrar`).
+ * 2. Consulta la agenda de ocupación (`AgendaAlojamientos::filtrarLibres`), que con una
+ *    búsqueda binaria por candidato deja en el mismo buffer los alojamientos libres en las
+ *    fechas deseadas.
+ *
+ * Ninguna de las fases reserva memoria proporcional al catálogo ni copia alojamientos.
+ *
+ * Los resultados se guardan en una cache LRU indexada por la consulta normalizada; una
+ * consulta repetida solo copia los índices guardados. Las entradas se descartan cuando una
+ * reservación nueva o cancelada del mismo municipio se cruza con sus noches.
  *
  * @param municipio Municipio donde se desea realizar la reserva.
  * @param fechaEntrada Fecha de inicio de la reserva.
  * @param noches Número de noches que se desea reservar.
  * @param precioMax Precio máximo por noche permitido. Si es negativo, no se filtra por precio.
  * @param puntuacionMin Puntuación mínima del anfitrión permitida. Si es negativa, no se filtra por puntuación.
+ * @param amenidadesRequeridas Amenidades separadas por comas que deben estar todas presentes.
+ *                             Si está vacía no se filtra; si alguna no existe no hay resultados.
  * @param cantidadEncontrada Parámetro de salida con la cantidad de alojamientos disponibles encontrados.
- * @return Puntero a un arreglo dinámico de alojamientos disponibles. Puede ser `nullptr` si no hay coincidencias. El arreglo debe liberarse con `delete[]`.
+ * @param facetas [out] Si no es nullptr, recibe los conteos de los resultados por rango de precio,
+ *                rango de puntuación, tipo y amenidad (ver `CatalogoAlojamientos::contarFacetas`),
+ *                calculados en un solo recorrido de los resultados.
+ * @return Índices de los alojamientos disponibles dentro de `getAlojamientos()`, del más barato
+ *         al más caro. El arreglo pertenece al sistema y solo es válido hasta la siguiente
+ *         búsqueda; no debe liberarse.
  */
-Alojamiento* Sistema::buscarAlojamientosDisponibles(const string& municipio,
-                                                    const Fecha& fechaEntrada,
-                                                    int noches,
-                                                    float precioMax,
-                                                    float puntuacionMin,
-                                                    int& cantidadEncontrada) {
-    // 1. Filtrar por criterios basicos
-    int nFiltrados = 0;
-    Alojamiento* candidatos = filtrarAlojamientosDisponibles(
-        municipio, precioMax, puntuacionMin, nFiltrados
+const int* Sistema::buscarAlojamientosDisponibles(const string& municipio,
+                                                  const Fecha& fechaEntrada,
+                                                  int noches,
+                                                  float precioMax,
+                                                  float puntuacionMin,
+                                                  const string& amenidadesRequeridas,
+                                                  int& cantidadEncontrada,
+                                                  FacetasBusqueda* facetas) {
+    int diaEntrada = fechaEntrada.aDiasDesdeFechaBase();
+
+    // 1. Consultas repetidas: se copian los resultados guardados
+    string clave = CacheBusquedas::construirClave(municipio, diaEntrada, noches, precioMax,
+                                                  puntuacionMin, amenidadesRequeridas);
+    if (cacheBusquedas->buscar(clave, bufferBusqueda, cantidadEncontrada)) {
+        if (facetas) catalogo->contarFacetas(bufferBusqueda, cantidadEncontrada, *facetas);
+        return bufferBusqueda;
+    }
+
+    // 2. Filtrar por criterios basicos
+    int nFiltrados = filtrarCandidatos(municipio, precioMax, puntuacionMin, amenidadesRequeridas);
+
+    // 3. Filtrar por disponibilidad de fechas (en el mismo buffer)
+    cantidadEncontrada = agenda->filtrarLibres(bufferBusqueda, nFiltrados, diaEntrada, noches);
+
+    cacheBusquedas->guardar(clave, municipio, diaEntrada, noches, bufferBusqueda, cantidadEncontrada);
+
+    // 4. Conteos para refinar la busqueda, si se piden
+    if (facetas) catalogo->contarFacetas(bufferBusqueda, cantidadEncontrada, *facetas);
+    return bufferBusqueda;
+}
+
+/**
+ * @brief Busca alojamientos con al menos una fecha de entrada posible dentro de una ventana.
+ *
+ * Reemplaza a repetir la búsqueda con cada fecha de la ventana: los candidatos se filtran
+ * una sola vez por municipio, precio, puntuación y amenidades, y para cada uno se recorre
+ * una vez su agenda de reservaciones ordenada, deteniéndose en el primer hueco de `noches`
+ * noches que empiece entre `desde` y `hasta`.
+ *
+ * @param municipio Municipio donde se desea realizar la reserva.
+ * @param desde Primera fecha de entrada aceptable.
+ * @param hasta Última fecha de entrada aceptable.
+ * @param noches Número de noches que se desea reservar.
+ * @param precioMax Precio máximo por noche permitido. Si es negativo, no se filtra por precio.
+ * @param puntuacionMin Puntuación mínima del anfitrión permitida. Si es negativa, no se filtra por puntuación.
+ * @param amenidadesRequeridas Amenidades separadas por comas que deben estar todas presentes.
+ * @param cantidadEncontrada [out] Cantidad de alojamientos encontrados.
+ * @return Índices de los alojamientos encontrados dentro de `getAlojamientos()`, del más barato
+ *         al más caro. El arreglo pertenece al sistema y solo es válido hasta la siguiente
+ *         búsqueda; no debe liberarse. Las fechas posibles de cada uno se obtienen con
+ *         `obtenerFechasInicioPosibles`.
+ */
+const int* Sistema::buscarAlojamientosFlexibles(const string& municipio,
+                                                const Fecha& desde,
+                                                const Fecha& hasta,
+                                                int noches,
+                                                float precioMax,
+                                                float puntuacionMin,
+                                                const string& amenidadesRequeridas,
+                                                int& cantidadEncontrada) {
+    int nFiltrados = filtrarCandidatos(municipio, precioMax, puntuacionMin, amenidadesRequeridas);
+
+    cantidadEncontrada = agenda->filtrarConInicioPosible(
+        bufferBusqueda, nFiltrados, desde.aDiasDesdeFechaBase(), hasta.aDiasDesdeFechaBase(), noches
         );
 
-    if (nFiltrados == 0) {
-        cantidadEncontrada = 0;
-        return nullptr;
+    return bufferBusqueda;
+}
+
+/**
+ * @brief Calcula todas las fechas de entrada posibles de un alojamiento dentro de una ventana.
+ *
+ * @param indiceAlojamiento Índice del alojamiento en `getAlojamientos()`.
+ * @param desde Primera fecha de entrada aceptable.
+ * @param hasta Última fecha de entrada aceptable.
+ * @param noches Número de noches de la estadía.
+ * @param numRangos [out] Cantidad de rangos de fechas retornados.
+ * @return Arreglo de 2 * numRangos fechas con pares [primera, última] fecha de entrada posible,
+ *         o nullptr si no hay ninguna.
+ *
+ * @note El arreglo retornado debe ser liberado por el llamador con delete[].
+ */
+Fecha* Sistema::obtenerFechasInicioPosibles(int indiceAlojamiento, const Fecha& desde, const Fecha& hasta,
+                                            int noches, int& numRangos) const {
+    numRangos = 0;
+    if (indiceAlojamiento < 0 || indiceAlojamiento >= numAlojamientos) return nullptr;
+
+    int capacidad = 2 * (agenda->getNumIntervalos(indiceAlojamiento) + 1);
+    int* dias = new int[capacidad];
+    agregarMemoria(sizeof(int) * capacidad);
+
+    numRangos = agenda->calcularIniciosPosibles(indiceAlojamiento, desde.aDiasDesdeFechaBase(),
+                                                hasta.aDiasDesdeFechaBase(), noches, dias);
+
+    Fecha* rangos = nullptr;
+    if (numRangos > 0) {
+        rangos = new Fecha[2 * numRangos];
+        agregarMemoria(sizeof(Fecha) * 2 * numRangos);
+        for (int i = 0; i < 2 * numRangos; ++i) {
+            incrementarIteracion();
+            rangos[i] = Fecha::desdeDiasFechaBase(dias[i]);
+        }
+    }
+
+    delete[] dias;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * capacidad));
+    return rangos;
+}
+
+/**
+ * @brief Busca alojamientos disponibles y retorna una página de resultados ordenados.
+ *
+ * Usa `buscarAlojamientosDisponibles` para obtener los candidatos, que ya vienen del más
+ * barato al más caro, y solo ordena lo necesario para la página pedida:
+ * - 'P' (precio por noche) y 'T' (costo total de la estadía = precio * noches): para una
+ *   cantidad de noches fija ambos coinciden con el orden de los candidatos, así que la
+ *   página es directamente un tramo del resultado.
+ * - 'R' (puntuación del anfitrión, de mayor a menor; empates por precio): se hace una
+ *   selección parcial (`partial_sort`) de los primeros `desplazamiento + limite` candidatos,
+ *   en O(n log k), sin ordenar el resto.
+ *
+ * @param municipio Municipio donde se desea realizar la reserva.
+ * @param fechaEntrada Fecha de inicio de la reserva.
+ * @param noches Número de noches que se desea reservar.
+ * @param precioMax Precio máximo por noche permitido. Si es negativo, no se filtra por precio.
+ * @param puntuacionMin Puntuación mínima del anfitrión permitida. Si es negativa, no se filtra por puntuación.
+ * @param amenidadesRequeridas Amenidades separadas por comas que deben estar todas presentes.
+ * @param criterioOrden 'P' (precio), 'R' (puntuación del anfitrión) o 'T' (costo total).
+ * @param limite Cantidad máxima de resultados de la página.
+ * @param desplazamiento Cantidad de resultados que se omiten antes de la página.
+ * @param cantidadPagina [out] Cantidad de índices en la página retornada.
+ * @param totalEncontrados [out] Cantidad total de alojamientos que cumplen los criterios.
+ * @param facetas [out] Si no es nullptr, recibe los conteos de todos los resultados (no solo
+ *                de la página) por faceta.
+ * @return Índices (dentro de `getAlojamientos()`) de la página. El arreglo pertenece al sistema
+ *         y solo es válido hasta la siguiente búsqueda; no debe liberarse.
+ *
+ * @throws std::invalid_argument si el criterio no es válido o el límite o el desplazamiento son negativos.
+ */
+const int* Sistema::buscarAlojamientosOrdenados(const string& municipio,
+                                                const Fecha& fechaEntrada,
+                                                int noches,
+                                                float precioMax,
+                                                float puntuacionMin,
+                                                const string& amenidadesRequeridas,
+                                                char criterioOrden,
+                                                int limite,
+                                                int desplazamiento,
+                                                int& cantidadPagina,
+                                                int& totalEncontrados,
+                                                FacetasBusqueda* facetas) {
+    if (criterioOrden != 'P' && criterioOrden != 'R' && criterioOrden != 'T') {
+        throw invalid_argument("Criterio de orden invalido");
+    }
+    if (limite < 0 || desplazamiento < 0) {
+        throw invalid_argument("El limite y el desplazamiento no pueden ser negativos");
     }
 
-    // 2. Filtrar por disponibilidad de fechas
-    Alojamiento* disponibles = Reservacion::filtrarDisponiblesPorFecha(
-        candidatos, nFiltrados,
-        fechaEntrada, noches,
-        getReservaciones(), getNumReservaciones(),
-        cantidadEncontrada
+    const int* candidatos = buscarAlojamientosDisponibles(
+        municipio, fechaEntrada, noches, precioMax, puntuacionMin, amenidadesRequeridas, totalEncontrados,
+        facetas
         );
 
-    delete[] candidatos;
-    agregarMemoria(-sizeof(Alojamiento) * nFiltrados); // Memoria liberada
+    cantidadPagina = 0;
+    if (desplazamiento >= totalEncontrados) {
+        return candidatos;
+    }
+    int finPagina = (limite < totalEncontrados - desplazamiento) ? desplazamiento + limite : totalEncontrados;
+
+    if (criterioOrden == 'R') {
+        const CatalogoAlojamientos* cat = catalogo;
+        partial_sort(bufferBusqueda, bufferBusqueda + finPagina, bufferBusqueda + totalEncontrados,
+                     [cat](int a, int b) {
+                         incrementarIteracion();
+                         float puntuacionA = cat->getPuntuacionDeAlojamiento(a);
+                         float puntuacionB = cat->getPuntuacionDeAlojamiento(b);
+                         if (puntuacionA != puntuacionB) return puntuacionA > puntuacionB;
+                         return cat->getFilaDeAlojamiento(a) < cat->getFilaDeAlojamiento(b);
+                     });
+    }
+
+    cantidadPagina = finPagina - desplazamiento;
+    return bufferBusqueda + desplazamiento;
+}
+
+/**
+ * @brief Busca los alojamientos que cumplen los criterios pero no están libres en las fechas pedidas.
+ *
+ * Complementa a `buscarAlojamientosDisponibles`: aplica los mismos filtros y deja en el
+ * buffer de trabajo los candidatos ocupados en alguna de las noches, para ofrecerle al
+ * huésped su próxima fecha disponible (ver `obtenerProximasFechasDisponibles`).
+ *
+ * @param municipio Municipio donde se desea realizar la reserva.
+ * @param fechaEntrada Fecha de inicio de la reserva.
+ * @param noches Número de noches que se desea reservar.
+ * @param precioMax Precio máximo por noche permitido. Si es negativo, no se filtra por precio.
+ * @param puntuacionMin Puntuación mínima del anfitrión permitida. Si es negativa, no se filtra por puntuación.
+ * @param amenidadesRequeridas Amenidades separadas por comas que deben estar todas presentes.
+ * @param cantidadEncontrada Parámetro de salida con la cantidad de alojamientos ocupados encontrados.
+ * @return Índices de los alojamientos ocupados dentro de `getAlojamientos()`, del más barato al
+ *         más caro. El arreglo pertenece al sistema y solo es válido hasta la siguiente
+ *         búsqueda; no debe liberarse.
+ */
+const int* Sistema::buscarAlojamientosOcupados(const string& municipio,
+                                               const Fecha& fechaEntrada,
+                                               int noches,
+                                               float precioMax,
+                                               float puntuacionMin,
+                                               const string& amenidadesRequeridas,
+                                               int& cantidadEncontrada) {
+    int diaEntrada = fechaEntrada.aDiasDesdeFechaBase();
+    int nFiltrados = filtrarCandidatos(municipio, precioMax, puntuacionMin, amenidadesRequeridas);
+
+    cantidadEncontrada = 0;
+    for (int i = 0; i < nFiltrados; ++i) {
+        incrementarIteracion();
+        int a = bufferBusqueda[i];
+        bufferBusqueda[cantidadEncontrada] = a;
+        cantidadEncontrada += agenda->estaLibre(a, diaEntrada, noches) ? 0 : 1;
+    }
+    return bufferBusqueda;
+}
+
+/**
+ * @brief Primera fecha de entrada, desde una fecha dada, en que un alojamiento tiene las noches libres.
+ *
+ * Recorre los huecos entre las reservaciones ordenadas del alojamiento
+ * (`AgendaAlojamientos::buscarProximaEntradaLibre`). O(log k + huecos recorridos).
+ *
+ * @param indiceAlojamiento Índice del alojamiento en `getAlojamientos()`.
+ * @param desde Primera fecha de entrada aceptable.
+ * @param noches Número de noches de la estadía.
+ * @return Primera fecha de entrada posible (igual a `desde` si ya está libre).
+ *
+ * @throws std::out_of_range si el índice no corresponde a un alojamiento.
+ * @throws std::invalid_argument si la cantidad de noches no es positiva.
+ */
+Fecha Sistema::obtenerProximaFechaDisponible(int indiceAlojamiento, const Fecha& desde, int noches) const {
+    if (indiceAlojamiento < 0 || indiceAlojamiento >= numAlojamientos) {
+        throw out_of_range("Indice de alojamiento fuera de rango.");
+    }
+    if (noches <= 0) {
+        throw invalid_argument("La cantidad de noches debe ser positiva.");
+    }
+    return Fecha::desdeDiasFechaBase(
+        agenda->buscarProximaEntradaLibre(indiceAlojamiento, desde.aDiasDesdeFechaBase(), noches));
+}
+
+/**
+ * @brief Próxima fecha disponible de cada alojamiento de un conjunto de resultados.
+ *
+ * @param indicesAlojamientos Índices de los alojamientos en `getAlojamientos()`.
+ * @param cantidad Cantidad de alojamientos.
+ * @param desde Primera fecha de entrada aceptable.
+ * @param noches Número de noches de la estadía.
+ * @return Arreglo de `cantidad` fechas, en el mismo orden de los índices, o nullptr si
+ *         `cantidad` es 0.
+ *
+ * @throws std::out_of_range si algún índice no corresponde a un alojamiento.
+ * @throws std::invalid_argument si la cantidad de noches no es positiva.
+ * @note El arreglo retornado debe ser liberado por el llamador con delete[].
+ */
+Fecha* Sistema::obtenerProximasFechasDisponibles(const int* indicesAlojamientos, int cantidad,
+                                                 const Fecha& desde, int noches) const {
+    if (noches <= 0) {
+        throw invalid_argument("La cantidad de noches debe ser positiva.");
+    }
+    if (cantidad <= 0) {
+        return nullptr;
+    }
+    for (int i = 0; i < cantidad; ++i) {
+        if (indicesAlojamientos[i] < 0 || indicesAlojamientos[i] >= numAlojamientos) {
+            throw out_of_range("Indice de alojamiento fuera de rango.");
+        }
+    }
 
-    return disponibles;
+    int diaDesde = desde.aDiasDesdeFechaBase();
+    Fecha* fechas = new Fecha[cantidad];
+    agregarMemoria(sizeof(Fecha) * cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        fechas[i] = Fecha::desdeDiasFechaBase(
+            agenda->buscarProximaEntradaLibre(indicesAlojamientos[i], diaDesde, noches));
+    }
+    return fechas;
 }
 
 /**
@@ -566,13 +1204,23 @@ string Sistema::generarCodigoReservacion() {
     ultimoIdReservacion++;
     gestionArchivos->guardarUltimoIdReservacion(ultimoIdReservacion);
 
+    return formatearCodigoReservacion(ultimoIdReservacion);
+}
+
+/**
+ * @brief Construye el código de una reservación a partir de su ID secuencial.
+ *
+ * @param id ID secuencial de la reservación.
+ * @return Código con el formato "RES-<ID>-<N><L>" (ver `generarCodigoReservacion`).
+ */
+string Sistema::formatearCodigoReservacion(int id) {
     // Generar sufijo aleatorio
     int sufijoNum = rand() % 9000 + 1000;  // Numero entre 1000-9999
     char sufijoLetra = 'A' + (rand() % 26); // Letra entre A-Z
 
     // Construir el codigo completo
     ostringstream oss;
-    oss << "RES-" << ultimoIdReservacion << "-" << sufijoNum << sufijoLetra;
+    oss << "RES-" << id << "-" << sufijoNum << sufijoLetra;
 
     return oss.str();
 }
@@ -613,8 +1261,9 @@ bool Sistema::validarDisponibilidadHuesped(const string& documentoHuesped,
  *
  * Este método:
  * - Crea un nuevo arreglo de tamaño incrementado.
- * - Copia las reservaciones existentes.
- * - Agrega la nueva reservación al final.
+ * - Copia las reservaciones existentes dejando un espacio en la posición que conserva el
+ *   orden por fecha de salida (ubicada con una búsqueda binaria).
+ * - Ubica ahí la nueva reservación y la registra en la agenda de su alojamiento.
  * - Sustituye el arreglo antiguo y actualiza el contador de reservaciones.
  * - Intenta guardar la reservación en el archivo correspondiente (con manejo de errores independiente).
  * - Mide el uso de memoria dinámicamente.
@@ -625,26 +1274,44 @@ bool Sistema::validarDisponibilidadHuesped(const string& documentoHuesped,
  */
 void Sistema::agregarReservacion(const Reservacion& reservacion) {
     try {
+        int diaEntrada = Fecha(reservacion.getFechaEntrada()).aDiasDesdeFechaBase();
+        int posicion = contarReservacionesQueSalenHasta(diaEntrada + reservacion.getDuracion());
+
         // 1. Crear nuevo array mas grande
         Reservacion* nuevasReservaciones = new Reservacion[numReservaciones + 1];
 
         // Registrar memoria utilizada
         agregarMemoria(sizeof(Reservacion) * (numReservaciones + 1));
 
-        // 2. Copiar reservaciones existentes
+        // 2. Copiar reservaciones existentes dejando libre la posicion de la nueva
         for (int i = 0; i < numReservaciones; i++) {
-            nuevasReservaciones[i] = reservaciones[i];
+            nuevasReservaciones[(i < posicion) ? i : i + 1] = reservaciones[i];
             incrementarIteracion();
         }
 
-        // 3. Agregar la nueva reservacion
-        nuevasReservaciones[numReservaciones] = reservacion;
+        // 3. Agregar la nueva reservacion con su huesped ya resuelto
+        nuevasReservaciones[posicion] = reservacion;
+        nuevasReservaciones[posicion].setIndiceHuesped(
+            indiceHuespedes.buscar(reservacion.getDocumento()));
 
         // 4. Reemplazar el array antiguo
         agregarMemoria(-sizeof(Reservacion) * numReservaciones);
         delete[] reservaciones;
         reservaciones = nuevasReservaciones;
         numReservaciones++;
+        duracionMaximaReservacion = max(duracionMaximaReservacion, reservacion.getDuracion());
+
+        // Registrar las noches ocupadas en la agenda del alojamiento y descartar
+        // las busquedas guardadas que las incluian como libres
+        int indiceAlojamiento = indiceAlojamientos.buscar(reservacion.getCodigoAlojamiento());
+        agenda->desplazarReservaciones(posicion);
+        registrarNochesEnDisponibilidad(indiceAlojamiento, diaEntrada, reservacion.getDuracion(), 1);
+        agenda->agregar(indiceAlojamiento, diaEntrada, reservacion.getDuracion(), posicion);
+        if (indiceAlojamiento >= 0) {
+            cacheBusquedas->invalidar(alojamientos[indiceAlojamiento].getMunicipio(), diaEntrada,
+                                      reservacion.getDuracion());
+        }
+        registrarPagoEnResumen(reservacion, 1);
 
         // 5. Guardar en archivo (manejar error aparte para no perder datos)
         try {
@@ -660,6 +1327,222 @@ void Sistema::agregarReservacion(const Reservacion& reservacion) {
     }
 }
 
+/**
+ * @brief Registra un lote de reservaciones sin interacción con el usuario.
+ *
+ * Pensado para agencias que reservan muchas estadías a la vez. Funciona en tres fases:
+ * 1. Validación de cada solicitud (fecha futura, noches, método de pago, alojamiento y
+ *    huésped existentes). Las estadías ya registradas de los huéspedes del lote se agrupan
+ *    por huésped con un ordenamiento por conteo, en un solo recorrido de las reservaciones.
+ * 2. Barrido de las solicitudes válidas ordenadas por fecha de entrada (empates en el orden
+ *    del lote). Por cada alojamiento y cada huésped se guarda la salida de la última
+ *    solicitud aceptada: como llegan ordenadas, una solicitud choca con una ganadora del
+ *    lote solo si entra antes de esa salida. Los choques con reservaciones registradas se
+ *    resuelven con la agenda del alojamiento (búsqueda binaria) y con las estadías
+ *    agrupadas del huésped. Ante un conflicto gana la solicitud que entra primero.
+ * 3. Las ganadoras se mezclan de una vez en el arreglo ordenado por salida, la agenda se
+ *    reconstruye una sola vez y se escriben juntas en el archivo de reservaciones (una sola
+ *    apertura), al igual que el último ID usado.
+ *
+ * @param solicitudes [in/out] Solicitudes del lote; cada una recibe su `resultado` y, si
+ *                    quedó reservada, su `codigoReservacion`.
+ * @param cantidad Cantidad de solicitudes.
+ * @return Cantidad de solicitudes reservadas.
+ *
+ * @throws std::bad_alloc Si no hay memoria suficiente para ampliar el arreglo.
+ */
+int Sistema::reservarEnLote(SolicitudReservacion* solicitudes, int cantidad) {
+    if (cantidad <= 0) {
+        return 0;
+    }
+
+    // 1. Validacion: alojamiento, huesped y dia de entrada de cada solicitud
+    int* alojamientoDe = new int[cantidad];
+    int* huespedDe = new int[cantidad];
+    int* entradaDe = new int[cantidad];
+    int* orden = new int[cantidad];
+    char* huespedEnLote = new char[numHuespedes + 1]();
+    agregarMemoria(sizeof(int) * 4 * cantidad + sizeof(char) * (numHuespedes + 1));
+
+    int numValidas = 0;
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        SolicitudReservacion& solicitud = solicitudes[i];
+        solicitud.codigoReservacion = "";
+        solicitud.metodoPago = static_cast<char>(toupper(solicitud.metodoPago));
+
+        if (!solicitud.fechaEntrada.esValida() || solicitud.fechaEntrada.yaPaso() || solicitud.noches <= 0 ||
+            (solicitud.metodoPago != 'T' && solicitud.metodoPago != 'P')) {
+            solicitud.resultado = SolicitudReservacion::DATOS_INVALIDOS;
+            continue;
+        }
+        alojamientoDe[i] = indiceAlojamientos.buscar(solicitud.codigoAlojamiento);
+        if (alojamientoDe[i] < 0) {
+            solicitud.resultado = SolicitudReservacion::ALOJAMIENTO_INEXISTENTE;
+            continue;
+        }
+        huespedDe[i] = indiceHuespedes.buscar(solicitud.documentoHuesped);
+        if (huespedDe[i] < 0) {
+            solicitud.resultado = SolicitudReservacion::HUESPED_INEXISTENTE;
+            continue;
+        }
+        entradaDe[i] = solicitud.fechaEntrada.aDiasDesdeFechaBase();
+        huespedEnLote[huespedDe[i]] = 1;
+        orden[numValidas++] = i;
+    }
+
+    // Estadias registradas de los huespedes del lote, agrupadas por huesped:
+    // [inicioEstadias[h], inicioEstadias[h + 1]) en estadias (pares entrada, salida)
+    int* inicioEstadias = new int[numHuespedes + 1]();
+    agregarMemoria(sizeof(int) * (numHuespedes + 1));
+    for (int r = 0; r < numReservaciones; ++r) {
+        incrementarIteracion();
+        int h = reservaciones[r].getIndiceHuesped();
+        if (h >= 0 && huespedEnLote[h]) {
+            inicioEstadias[h + 1]++;
+        }
+    }
+    for (int h = 0; h < numHuespedes; ++h) {
+        inicioEstadias[h + 1] += inicioEstadias[h];
+    }
+    int numEstadias = inicioEstadias[numHuespedes];
+    int* estadias = new int[2 * numEstadias + 1];
+    agregarMemoria(sizeof(int) * (2 * numEstadias + 1));
+    for (int r = numReservaciones - 1; r >= 0; --r) {
+        incrementarIteracion();
+        int h = reservaciones[r].getIndiceHuesped();
+        if (h >= 0 && huespedEnLote[h]) {
+            // La posicion h + 1 sirve de cursor que baja hasta el inicio del huesped
+            int posicion = --inicioEstadias[h + 1];
+            int salida = diaSalidaReservacion(r);
+            estadias[2 * posicion] = salida - reservaciones[r].getDuracion();
+            estadias[2 * posicion + 1] = salida;
+        }
+    }
+    for (int h = 0; h < numHuespedes; ++h) {
+        inicioEstadias[h] = inicioEstadias[h + 1];
+    }
+    inicioEstadias[numHuespedes] = numEstadias;
+
+    // 2. Barrido por fecha de entrada con la ultima salida aceptada de cada alojamiento y huesped
+    sort(orden, orden + numValidas, [entradaDe](int a, int b) {
+        incrementarIteracion();
+        if (entradaDe[a] != entradaDe[b]) return entradaDe[a] < entradaDe[b];
+        return a < b;
+    });
+
+    int* salidaAlojamiento = new int[numAlojamientos + 1];
+    int* salidaHuesped = new int[numHuespedes + 1];
+    agregarMemoria(sizeof(int) * (numAlojamientos + numHuespedes + 2));
+    fill(salidaAlojamiento, salidaAlojamiento + numAlojamientos + 1, INT_MIN);
+    fill(salidaHuesped, salidaHuesped + numHuespedes + 1, INT_MIN);
+
+    int numGanadoras = 0;
+    for (int k = 0; k < numValidas; ++k) {
+        incrementarIteracion();
+        int i = orden[k];
+        int a = alojamientoDe[i];
+        int h = huespedDe[i];
+        int entrada = entradaDe[i];
+        int salida = entrada + solicitudes[i].noches;
+
+        bool huespedOcupado = entrada < salidaHuesped[h];
+        for (int e = inicioEstadias[h]; e < inicioEstadias[h + 1] && !huespedOcupado; ++e) {
+            incrementarIteracion();
+            huespedOcupado = estadias[2 * e] < salida && entrada < estadias[2 * e + 1];
+        }
+
+        if (entrada < salidaAlojamiento[a]) {
+            solicitudes[i].resultado = SolicitudReservacion::CONFLICTO_EN_LOTE;
+        } else if (!agenda->estaLibre(a, entrada, solicitudes[i].noches)) {
+            solicitudes[i].resultado = SolicitudReservacion::ALOJAMIENTO_OCUPADO;
+        } else if (huespedOcupado) {
+            solicitudes[i].resultado = SolicitudReservacion::HUESPED_OCUPADO;
+        } else {
+            solicitudes[i].resultado = SolicitudReservacion::RESERVADA;
+            salidaAlojamiento[a] = salida;
+            salidaHuesped[h] = salida;
+            orden[numGanadoras++] = i;  // Las ganadoras reutilizan el inicio de orden
+        }
+    }
+
+    delete[] salidaAlojamiento;
+    delete[] salidaHuesped;
+    delete[] estadias;
+    delete[] inicioEstadias;
+    delete[] huespedEnLote;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * (numAlojamientos + numHuespedes + 2)
+                                           + sizeof(int) * (2 * numEstadias + 1)
+                                           + sizeof(int) * (numHuespedes + 1)
+                                           + sizeof(char) * (numHuespedes + 1)));
+
+    // 3. Registrar las ganadoras, ordenadas por dia de salida como el arreglo del sistema
+    if (numGanadoras > 0) {
+        sort(orden, orden + numGanadoras, [entradaDe, solicitudes](int a, int b) {
+            incrementarIteracion();
+            int salidaA = entradaDe[a] + solicitudes[a].noches;
+            int salidaB = entradaDe[b] + solicitudes[b].noches;
+            if (salidaA != salidaB) return salidaA < salidaB;
+            return a < b;
+        });
+
+        Reservacion* ganadoras = new Reservacion[numGanadoras];
+        agregarMemoria(sizeof(Reservacion) * numGanadoras);
+        string fechaPago = Fecha::obtenerFechaActual();
+        for (int g = 0; g < numGanadoras; ++g) {
+            incrementarIteracion();
+            int i = orden[g];
+            SolicitudReservacion& solicitud = solicitudes[i];
+            const Alojamiento& alojamiento = alojamientos[alojamientoDe[i]];
+
+            solicitud.codigoReservacion = formatearCodigoReservacion(++ultimoIdReservacion);
+            ganadoras[g] = Reservacion(solicitud.codigoReservacion, solicitud.fechaEntrada.toString(),
+                                       solicitud.noches, alojamiento.getCodigo(), solicitud.documentoHuesped,
+                                       solicitud.metodoPago, fechaPago, alojamiento.getPrecio() * solicitud.noches,
+                                       solicitud.anotaciones);
+            ganadoras[g].setIndiceHuesped(huespedDe[i]);
+            duracionMaximaReservacion = max(duracionMaximaReservacion, solicitud.noches);
+
+            // Las noches estaban libres en la agenda: se cuentan antes de reconstruirla
+            registrarNochesEnDisponibilidad(alojamientoDe[i], entradaDe[i], solicitud.noches, 1);
+            cacheBusquedas->invalidar(alojamiento.getMunicipio(), entradaDe[i], solicitud.noches);
+            registrarPagoEnResumen(ganadoras[g], 1);
+        }
+
+        // Mezcla de los dos arreglos ordenados por salida (a igual salida, las existentes primero)
+        Reservacion* nuevasReservaciones = new Reservacion[numReservaciones + numGanadoras];
+        agregarMemoria(sizeof(Reservacion) * (numReservaciones + numGanadoras));
+        int r = 0;
+        int g = 0;
+        for (int destino = 0; destino < numReservaciones + numGanadoras; ++destino) {
+            incrementarIteracion();
+            bool tomarExistente = g == numGanadoras ||
+                (r < numReservaciones && diaSalidaReservacion(r) <= entradaDe[orden[g]] + solicitudes[orden[g]].noches);
+            nuevasReservaciones[destino] = tomarExistente ? reservaciones[r++] : ganadoras[g++];
+        }
+
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * numReservaciones));
+        delete[] reservaciones;
+        reservaciones = nuevasReservaciones;
+        numReservaciones += numGanadoras;
+        agenda->construir(numAlojamientos, reservaciones, numReservaciones, indiceAlojamientos);
+
+        // Una sola escritura para todo el lote
+        gestionArchivos->guardarReservaciones(ganadoras, numGanadoras);
+        gestionArchivos->guardarUltimoIdReservacion(ultimoIdReservacion);
+
+        delete[] ganadoras;
+        agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * numGanadoras));
+    }
+
+    delete[] alojamientoDe;
+    delete[] huespedDe;
+    delete[] entradaDe;
+    delete[] orden;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 4 * cantidad));
+    return numGanadoras;
+}
+
 /**
  * @brief Elimina una reservación del sistema según su código y el documento del huésped.
  *
@@ -679,6 +1562,22 @@ bool Sistema::eliminarReservacionPorCodigo(const string& codigo, const string& d
         if (reservaciones[i].getCodigo() == codigo &&
             reservaciones[i].getDocumento() == documento) {
 
+            // Liberar sus noches en la agenda; las reservaciones siguientes bajan una posicion
+            int indiceAlojamiento = indiceAlojamientos.buscar(reservaciones[i].getCodigoAlojamiento());
+            agenda->eliminar(indiceAlojamiento, i);
+            agenda->descontarReservacion(i);
+            registrarNochesEnDisponibilidad(indiceAlojamiento,
+                                            Fecha(reservaciones[i].getFechaEntrada()).aDiasDesdeFechaBase(),
+                                            reservaciones[i].getDuracion(), -1);
+
+            // Las busquedas guardadas que se cruzan con esas noches ya no estan completas
+            if (indiceAlojamiento >= 0) {
+                cacheBusquedas->invalidar(alojamientos[indiceAlojamiento].getMunicipio(),
+                                          Fecha(reservaciones[i].getFechaEntrada()).aDiasDesdeFechaBase(),
+                                          reservaciones[i].getDuracion());
+            }
+            registrarPagoEnResumen(reservaciones[i], -1);
+
             // Reorganizar el arreglo (no se usa delete porque son objetos, no punteros)
             for (int j = i; j < numReservaciones - 1; ++j) {
                 reservaciones[j] = reservaciones[j + 1];
@@ -781,17 +1680,97 @@ Reservacion* Sistema::obtenerReservaciones(const string& documentoHuesped,
     return resultado;
 }
 
+/**
+ * @brief Obtiene el historial completo de un huésped: reservaciones activas e históricas.
+ *
+ * Las activas salen del arreglo en memoria (ver `obtenerReservaciones`). Las históricas se
+ * leen del archivo segmentado a través de su índice por huésped, que indica los segmentos
+ * donde aparece el documento; de esos segmentos solo se leen los bloques que lo contienen,
+ * así que el histórico nunca se carga completo. Una reservación que siga en el arreglo
+ * activo (por ejemplo, si se interrumpió un corte) no se repite.
+ *
+ * @param documentoHuesped Documento identificador del huésped.
+ * @param totalFuturas [out] Reservaciones activas que aún no terminan.
+ * @param totalPasadas [out] Reservaciones activas que ya terminaron.
+ * @param totalHistoricas [out] Reservaciones movidas al histórico.
+ * @return Arreglo con las futuras, luego las pasadas y al final las históricas (de la más
+ *         reciente a la más antigua por fecha de entrada), o nullptr si no hay ninguna.
+ *
+ * @note El arreglo retornado debe ser liberado por el llamador para evitar fugas de memoria.
+ */
+Reservacion* Sistema::obtenerHistorialHuesped(const string& documentoHuesped,
+                                              int& totalFuturas,
+                                              int& totalPasadas,
+                                              int& totalHistoricas) const {
+    Reservacion* activas = obtenerReservaciones(documentoHuesped, totalFuturas, totalPasadas);
+    int numActivas = totalFuturas + totalPasadas;
+
+    int numHistoricas = 0;
+    Reservacion* historicas = gestionArchivos->getHistorico().consultarPorHuesped(documentoHuesped, numHistoricas);
+
+    // Codigos activos, para no repetir una reservacion que quedo en ambos lados
+    IndiceHash codigosActivos;
+    codigosActivos.reservar(numActivas);
+    for (int i = 0; i < numActivas; ++i) {
+        incrementarIteracion();
+        codigosActivos.insertar(activas[i].getCodigo(), i);
+    }
+
+    // Historicas de la mas reciente a la mas antigua
+    int* orden = new int[numHistoricas > 0 ? numHistoricas : 1];
+    int* diasEntrada = new int[numHistoricas > 0 ? numHistoricas : 1];
+    agregarMemoria(sizeof(int) * 2 * numHistoricas);
+    totalHistoricas = 0;
+    for (int i = 0; i < numHistoricas; ++i) {
+        incrementarIteracion();
+        if (codigosActivos.buscar(historicas[i].getCodigo()) >= 0) continue;
+        diasEntrada[i] = Fecha(historicas[i].getFechaEntrada()).aDiasDesdeFechaBase();
+        orden[totalHistoricas++] = i;
+    }
+    stable_sort(orden, orden + totalHistoricas, [diasEntrada](int a, int b) {
+        return diasEntrada[a] > diasEntrada[b];
+    });
+
+    Reservacion* resultado = nullptr;
+    if (numActivas + totalHistoricas > 0) {
+        resultado = new Reservacion[numActivas + totalHistoricas];
+        agregarMemoria(sizeof(Reservacion) * (numActivas + totalHistoricas));
+        for (int i = 0; i < numActivas; ++i) {
+            incrementarIteracion();
+            resultado[i] = activas[i];
+        }
+        for (int i = 0; i < totalHistoricas; ++i) {
+            incrementarIteracion();
+            resultado[numActivas + i] = historicas[orden[i]];
+        }
+    }
+
+    delete[] orden;
+    delete[] diasEntrada;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * numHistoricas));
+    delete[] activas;
+    agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * numActivas));
+    delete[] historicas;
+    agregarMemoria(-static_cast<long long>(sizeof(Reservacion) * numHistoricas));
+
+    return resultado;
+}
+
 /**
  * @brief Obtiene todas las reservaciones activas de un anfitrión dentro de un rango de fechas.
  *
  * Se buscan las reservaciones cuyo alojamiento pertenece al anfitrión especificado y cuya fecha de
- * entrada se encuentra dentro del rango indicado.
+ * entrada se encuentra dentro del rango indicado. Los alojamientos del anfitrión salen del índice
+ * por anfitrión y, como la agenda guarda las reservaciones de cada alojamiento ordenadas por fecha
+ * de entrada, las del rango forman un tramo contiguo que se ubica con dos búsquedas binarias.
+ * No se recorre el arreglo completo de reservaciones.
  *
  * @param documentoAnfitrion Documento identificador del anfitrión.
  * @param fechaInicio Fecha inicial del rango.
  * @param fechaFin Fecha final del rango.
  * @param totalEncontradas Referencia a entero donde se almacenará la cantidad de reservaciones encontradas.
- * @return Reservacion* Arreglo dinámico con las reservaciones encontradas, o nullptr si no hay ninguna.
+ * @return Reservacion* Arreglo dinámico con las reservaciones encontradas, agrupadas por alojamiento
+ *         y ordenadas por fecha de entrada, o nullptr si no hay ninguna.
  *
  * @note El arreglo retornado debe ser liberado por el llamador para evitar fugas de memoria.
  */
@@ -800,87 +1779,58 @@ Reservacion* Sistema::obtenerReservaciones(const string& documentoAnfitrion,
                                            const Fecha& fechaInicio,
                                            const Fecha& fechaFin,
                                            int& totalEncontradas) const {
-    const Reservacion* todasReservaciones = this->getReservaciones();
-    int totalReservaciones = this->getNumReservaciones();
-    const Alojamiento* alojamientos = this->getAlojamientos();
-    int totalAlojamientos = this->getNumAlojamientos();
-
-    // Primera pasada: contar reservaciones que cumplen criterios
     totalEncontradas = 0;
-    for (int i = 0; i < totalReservaciones; i++) {
-        if (esReservacionDelAnfitrionEnRango(todasReservaciones[i], documentoAnfitrion,
-                                             fechaInicio, fechaFin, alojamientos, totalAlojamientos)) {
-            totalEncontradas++;
-        }
-    }
 
-    if (totalEncontradas == 0) {
+    int cantidadAlojamientos = 0;
+    const int* suyos = getAlojamientosDeAnfitrion(indiceAnfitriones.buscar(documentoAnfitrion),
+                                                   cantidadAlojamientos);
+    if (cantidadAlojamientos == 0) {
         return nullptr;
     }
 
-    // Segunda pasada: llenar arreglo resultado
-    Reservacion* resultado = new Reservacion[totalEncontradas];
-    agregarMemoria(sizeof(Reservacion) * totalEncontradas);
+    int desde = fechaInicio.aDiasDesdeFechaBase();
+    int hasta = fechaFin.aDiasDesdeFechaBase();
+    int hoy = Fecha(Fecha::obtenerFechaActual()).aDiasDesdeFechaBase();
 
-    int index = 0;
+    // Primera pasada: ubicar el tramo de cada alojamiento y contar las activas (no han salido)
+    int* tramos = new int[2 * cantidadAlojamientos];
+    agregarMemoria(sizeof(int) * 2 * cantidadAlojamientos);
 
-    for (int i = 0; i < totalReservaciones; i++) {
-        if (esReservacionDelAnfitrionEnRango(todasReservaciones[i], documentoAnfitrion,
-                                             fechaInicio, fechaFin, alojamientos, totalAlojamientos)) {
-            resultado[index++] = todasReservaciones[i];
+    for (int i = 0; i < cantidadAlojamientos; ++i) {
+        incrementarIteracion();
+        tramos[2 * i + 1] = agenda->buscarEntradasEnRango(suyos[i], desde, hasta, tramos[2 * i]);
+
+        const IntervaloOcupado* lista = agenda->getIntervalos(suyos[i]);
+        for (int k = tramos[2 * i]; k < tramos[2 * i] + tramos[2 * i + 1]; ++k) {
+            incrementarIteracion();
+            if (lista[k].fin >= hoy) {
+                totalEncontradas++;
+            }
         }
     }
 
-    return resultado;
-}
+    // Segunda pasada: copiar los tramos al arreglo resultado
+    Reservacion* resultado = nullptr;
+    if (totalEncontradas > 0) {
+        resultado = new Reservacion[totalEncontradas];
+        agregarMemoria(sizeof(Reservacion) * totalEncontradas);
 
-/**
- * @brief Verifica si una reservación pertenece a un alojamiento de un anfitrión dado y está en un rango de fechas activo.
- *
- * Este método privado busca determinar si la reservación pertenece a alguno de los alojamientos
- * que administra el anfitrión identificado por `documentoAnfitrion`. Además, verifica que la reservación
- * esté activa y que su fecha de entrada esté dentro del rango [fechaInicio, fechaFin].
- *
- * @param reserva Referencia a la reservación a evaluar.
- * @param documentoAnfitrion Documento identificador del anfitrión.
- * @param fechaInicio Fecha inicial del rango a consultar.
- * @param fechaFin Fecha final del rango a consultar.
- * @param alojamientos Arreglo de alojamientos existentes en el sistema.
- * @param totalAlojamientos Número total de alojamientos.
- * @return true Si la reservación pertenece al anfitrión y está activa dentro del rango.
- * @return false En caso contrario.
- *
- * @note Método privado usado para filtrar reservaciones del anfitrión en un rango dado.
- */
-bool Sistema::esReservacionDelAnfitrionEnRango(const Reservacion& reserva,
-                                               const string& documentoAnfitrion,
-                                               const Fecha& fechaInicio,
-                                               const Fecha& fechaFin,
-                                               const Alojamiento* alojamientos,
-                                               int totalAlojamientos) const {
-    // Verificar si la reservacion corresponde a un alojamiento del anfitrion
-    bool esDelAnfitrion = false;
-    for (int i = 0; i < totalAlojamientos; i++) {
-        incrementarIteracion();
-        if (alojamientos[i].getCodigo() == reserva.getCodigoAlojamiento() &&
-            alojamientos[i].getDocumentoAnfitrion() == documentoAnfitrion) {
-            esDelAnfitrion = true;
-            break;
+        int index = 0;
+        for (int i = 0; i < cantidadAlojamientos; ++i) {
+            const IntervaloOcupado* lista = agenda->getIntervalos(suyos[i]);
+            for (int k = tramos[2 * i]; k < tramos[2 * i] + tramos[2 * i + 1]; ++k) {
+                incrementarIteracion();
+                if (lista[k].fin >= hoy) {
+                    resultado[index++] = reservaciones[lista[k].reservacion];
+                }
+            }
         }
     }
 
-    if (!esDelAnfitrion) {
-        return false;
-    }
-
-    // Verificar si esta en el rango de fechas y es activa
-    Fecha fechaEntrada(reserva.getFechaEntrada());
-    Fecha fechaSalida = fechaEntrada.sumarDias(reserva.getDuracion());
+    delete[] tramos;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * 2 * cantidadAlojamientos));
 
-    // Reservacion activa: no ha terminado aun y esta en el rango
-    return !fechaSalida.yaPaso() &&
-           fechaEntrada >= fechaInicio &&
-           fechaEntrada <= fechaFin;
+    return resultado;
 }
 
 /**
@@ -933,16 +1883,121 @@ void Sistema::mostrarEstadisticasHistorico(const Fecha& fechaCorte, int finaliza
     cout << "==========================================\n";
 }
 
+/**
+ * @brief Mueve al histórico las primeras reservaciones del arreglo (las ya finalizadas).
+ *
+ * El prefijo se guarda directamente en "HistoricoReservaciones.txt", las activas pasan a un
+ * arreglo nuevo y la agenda descarta los intervalos retirados sin reconstruirse. Lo usan
+ * tanto la actualización manual del anfitrión como el corte automático diario.
+ *
+ * @note El costo es proporcional a las reservaciones activas, no a las que salen: se copian
+ *       todas las activas, la agenda recorre todos sus intervalos y se reescribe completo
+ *       "Reservaciones.txt". Es aceptable porque el corte ocurre a lo sumo una vez al día.
+ *
+ * @param finalizadas Cantidad de reservaciones finalizadas (ver `contarReservacionesQueSalenHasta`).
+ * @param fechaCorte Fecha de corte que se registra en la sección del histórico.
+ * @return true si se guardaron en el histórico y se retiraron del sistema; false si no se
+ *         pudo escribir el histórico (en ese caso no se modifica nada).
+ */
+bool Sistema::moverFinalizadasAlHistorico(int finalizadas, const Fecha& fechaCorte) {
+    // Las finalizadas se guardan directamente desde el inicio del arreglo
+    if (!gestionArchivos->guardarReservacionesHistorico(reservaciones, finalizadas, fechaCorte.toString())) {
+        return false;
+    }
+
+    int activas = numReservaciones - finalizadas;
+    Reservacion* reservacionesParaMantener = new Reservacion[activas];
+    agregarMemoria(sizeof(Reservacion) * activas);
+
+    for (int i = 0; i < activas; i++) {
+        incrementarIteracion();
+        reservacionesParaMantener[i] = reservaciones[finalizadas + i];
+    }
+
+    agregarMemoria(-sizeof(Reservacion) * numReservaciones);
+    delete[] reservaciones;
+
+    reservaciones = reservacionesParaMantener;
+    numReservaciones = activas;
+    agenda->eliminarPrimerasReservaciones(finalizadas);
+    cacheBusquedas->limpiar();
+    // Un corte con fecha futura tambien libera noches dentro del horizonte
+    construirDisponibilidad();
+
+    gestionArchivos->actualizarArchivoReservaciones(reservaciones, numReservaciones);
+    return true;
+}
+
+/**
+ * @brief Corte histórico automático: tarea diaria que se ejecuta en los puntos seguros del programa.
+ *
+ * Se invoca al arrancar, antes de que un comando por lotes o un menú lea las reservaciones
+ * activas, y al inicio de cada iteración de los menús, entre una acción del usuario y la
+ * siguiente, así que nunca interrumpe una consulta o una reservación en curso. Solo trabaja
+ * hasta completar el corte del día; después las llamadas del día retornan de inmediato. Si
+ * no se pudo escribir el histórico o la fecha de corte, el día no queda marcado y la
+ * siguiente llamada lo reintenta.
+ *
+ * Mueve al histórico las reservaciones finalizadas sin pedir confirmación y avanza
+ * "fecha_corte_historico.txt" hasta hoy, salvo que un anfitrión ya haya registrado una fecha
+ * posterior. La actualización manual con confirmación sigue disponible en el menú del anfitrión.
+ *
+ * No corre en un hilo aparte porque los arreglos de `Sistema` y los archivos de reservaciones
+ * se comparten con las reservaciones y cancelaciones sin sincronización alguna. Los hilos de
+ * los reportes de ocupación y de pagos solo leen copias durante una acción y terminan antes de
+ * que esta retorne, así que entre dos acciones no queda ninguno vivo.
+ *
+ * @note Fuera del arranque, el corte solo ocurre mientras se usa un menú: una sesión detenida
+ *       en una pregunta no mueve nada hasta la siguiente acción, aunque cambie el día, y el
+ *       usuario espera mientras se copian las activas y se reescribe "Reservaciones.txt".
+ *
+ * @return Cantidad de reservaciones movidas al histórico.
+ */
+int Sistema::ejecutarCorteHistoricoAutomatico() {
+    Fecha fechaHoy(Fecha::obtenerFechaActual());
+    int hoy = fechaHoy.aDiasDesdeFechaBase();
+    if (hoy == diaUltimoCorteAutomatico) {
+        return 0;
+    }
+
+    // Solo se avanza la fecha registrada; una fecha futura puesta por un anfitrion se respeta
+    string ultimaFechaStr = gestionArchivos->cargarUltimaFechaCorteHistorico();
+    bool avanzarFecha = true;
+    if (!ultimaFechaStr.empty()) {
+        Fecha ultimaFechaCorte(ultimaFechaStr);
+        avanzarFecha = !ultimaFechaCorte.esValida() || ultimaFechaCorte.aDiasDesdeFechaBase() < hoy;
+    }
+
+    // El dia solo se marca como hecho si todo quedo escrito; si algo falla se reintenta
+    // en el siguiente punto seguro
+    int finalizadas = contarReservacionesQueSalenHasta(hoy);
+    if (finalizadas > 0 && !moverFinalizadasAlHistorico(finalizadas, fechaHoy)) {
+        return 0;
+    }
+    if (finalizadas > 0) {
+        cout << "\n[Historico] " << finalizadas << " reservaciones finalizadas movidas automaticamente.\n";
+    }
+
+    if (avanzarFecha && !gestionArchivos->guardarUltimaFechaCorteHistorico(fechaHoy.toString())) {
+        return finalizadas;
+    }
+    diaUltimoCorteAutomatico = hoy;
+    return finalizadas;
+}
+
 /**
  * @brief Procesa la actualización del histórico de reservaciones a partir de una fecha de corte.
  *
- * Este método analiza todas las reservaciones actuales para determinar cuáles han finalizado
- * (su fecha final es anterior a la fecha actual), cuáles están activas y cuáles están en curso.
+ * Este método determina cuántas reservaciones han finalizado (su fecha final es anterior a la
+ * fecha actual), cuáles están activas y cuáles están en curso. Como el arreglo se mantiene
+ * ordenado por día de salida, las finalizadas son un prefijo que se ubica con una búsqueda
+ * binaria, y solo pueden estar en curso las que salen dentro de la duración máxima de una
+ * reservación a partir de hoy; no se calculan fechas de todas las reservaciones.
  *
  * Luego pregunta al usuario si desea mover las reservaciones finalizadas al archivo histórico.
- * Si confirma, se realiza la migración, actualizando los archivos correspondientes y liberando
- * la memoria de las reservaciones movidas. Además, actualiza la fecha de corte para la próxima
- * actualización.
+ * Si confirma, el prefijo se guarda directamente en el histórico, las activas pasan a un
+ * arreglo nuevo y la agenda descarta los intervalos retirados sin reconstruirse. Además,
+ * actualiza la fecha de corte para la próxima actualización.
  *
  * @param fechaCorte Fecha base que se utiliza para determinar qué reservaciones se consideran finalizadas.
  *
@@ -952,24 +2007,19 @@ void Sistema::mostrarEstadisticasHistorico(const Fecha& fechaCorte, int finaliza
 void Sistema::procesarActualizacionHistorico(const Fecha& fechaCorte) {
     cout << "\n=== ACTUALIZACION DE HISTORICO ===\n";
 
-    Fecha fechaHoy(Fecha::obtenerFechaActual());
+    int hoy = Fecha(Fecha::obtenerFechaActual()).aDiasDesdeFechaBase();
 
-    int reservacionesFinalizadas = 0;
-    int reservacionesActivas = 0;
-    int reservacionesEnCurso = 0;
+    // Finalizadas: su ultima noche fue antes de hoy (salen hoy o antes)
+    int reservacionesFinalizadas = contarReservacionesQueSalenHasta(hoy);
+    int reservacionesActivas = numReservaciones - reservacionesFinalizadas;
 
-    for (int i = 0; i < numReservaciones; i++) {
+    // En curso: activas que ya entraron; solo pueden serlo las que salen antes de hoy + duracion maxima
+    int reservacionesEnCurso = 0;
+    int limiteEnCurso = contarReservacionesQueSalenHasta(hoy + duracionMaximaReservacion);
+    for (int i = reservacionesFinalizadas; i < limiteEnCurso; i++) {
         incrementarIteracion();
-        Fecha fechaInicio(reservaciones[i].getFechaEntrada());
-        Fecha fechaFin = fechaInicio.calcularFechaFinal(reservaciones[i].getDuracion());
-
-        if (fechaFin < fechaHoy) {
-            reservacionesFinalizadas++;
-        } else {
-            reservacionesActivas++;
-            if (fechaInicio <= fechaHoy && fechaFin >= fechaHoy) {
-                reservacionesEnCurso++;
-            }
+        if (Fecha(reservaciones[i].getFechaEntrada()).aDiasDesdeFechaBase() <= hoy) {
+            reservacionesEnCurso++;
         }
     }
 
@@ -988,43 +2038,474 @@ void Sistema::procesarActualizacionHistorico(const Fecha& fechaCorte) {
     cin >> confirmar;
     if (confirmar != 's' && confirmar != 'S') return;
 
-    Reservacion* reservacionesParaHistorico = new Reservacion[reservacionesFinalizadas];
-    agregarMemoria(sizeof(Reservacion) * reservacionesFinalizadas);
+    if (moverFinalizadasAlHistorico(reservacionesFinalizadas, fechaCorte)) {
+        gestionArchivos->guardarUltimaFechaCorteHistorico(fechaCorte.toString());
+        cout << "Actualizacion completada. Activas: " << reservacionesActivas << endl;
+        mostrarEstadisticasHistorico(fechaCorte, reservacionesFinalizadas, reservacionesActivas, reservacionesEnCurso);
+    } else {
+        cout << "Error al guardar en historico.\n";
+    }
+}
+
+/**
+ * @brief Carga en una analítica las reservaciones activas e históricas de unos alojamientos.
+ *
+ * Las activas salen de la agenda de cada alojamiento (días de entrada y salida ya enteros).
+ * Las históricas se leen con entrada desde el 1 de enero del año anterior al reporte, para
+ * incluir las estadías que empezaron antes y terminan dentro del año. Se leen solo sus
+ * columnas numéricas (`ArchivoHistorico::leerFilas`) con un índice de código a posición en
+ * el reporte, así los grupos sin alojamientos del reporte se saltan y ninguna fecha se
+ * interpreta desde texto.
+ *
+ * @param analitica Analítica de destino (una posición por alojamiento del reporte).
+ * @param alojamientosReporte Índices de los alojamientos, en el orden de sus posiciones.
+ * @param numAlojamientosReporte Cantidad de alojamientos.
+ */
+void Sistema::cargarAnaliticaOcupacion(AnaliticaOcupacion& analitica, const int* alojamientosReporte,
+                                       int numAlojamientosReporte) const {
+    // 1. Reservaciones activas desde la agenda
+    for (int i = 0; i < numAlojamientosReporte; ++i) {
+        incrementarIteracion();
+        const IntervaloOcupado* intervalos = agenda->getIntervalos(alojamientosReporte[i]);
+        int numIntervalos = agenda->getNumIntervalos(alojamientosReporte[i]);
+        for (int k = 0; k < numIntervalos; ++k) {
+            incrementarIteracion();
+            analitica.agregarReservacion(i, intervalos[k].inicio, intervalos[k].fin - intervalos[k].inicio,
+                                         llround(reservaciones[intervalos[k].reservacion].getMonto()));
+        }
+    }
 
-    Reservacion* reservacionesParaMantener = new Reservacion[reservacionesActivas];
-    agregarMemoria(sizeof(Reservacion) * reservacionesActivas);
+    // 2. Reservaciones historicas, solo columnas numericas
+    IndiceHash posicionReporte;
+    posicionReporte.reservar(numAlojamientosReporte);
+    for (int i = 0; i < numAlojamientosReporte; ++i) {
+        incrementarIteracion();
+        posicionReporte.insertar(alojamientos[alojamientosReporte[i]].getCodigo(), i);
+    }
 
-    int iH = 0, iM = 0;
-    for (int i = 0; i < numReservaciones; i++) {
+    int cantidad = 0;
+    FilaHistorica* historicas = gestionArchivos->getHistorico().leerFilas(
+        Fecha(1, 1, analitica.getAnio() - 1).aDiasDesdeFechaBase(),
+        Fecha(31, 12, analitica.getAnio()).aDiasDesdeFechaBase(), posicionReporte, true, cantidad);
+    for (int k = 0; k < cantidad; ++k) {
+        incrementarIteracion();
+        analitica.agregarReservacion(historicas[k].alojamiento, historicas[k].diaEntrada, historicas[k].noches,
+                                     historicas[k].monto);
+    }
+    delete[] historicas;
+    agregarMemoria(-static_cast<long long>(sizeof(FilaHistorica) * cantidad));
+}
+
+/**
+ * @brief Calcula la ocupación, las noches vendidas y los ingresos mensuales de un anfitrión.
+ *
+ * @param documentoAnfitrion Documento del anfitrión.
+ * @param anio Año del reporte.
+ * @return Analítica con una posición por alojamiento, en el orden de
+ *         `getAlojamientosDeAnfitrion`, o nullptr si el anfitrión no existe.
+ *
+ * @throws std::invalid_argument si el año no es válido.
+ *
+ * @note El objeto retornado debe ser liberado por el llamador con delete.
+ */
+AnaliticaOcupacion* Sistema::calcularOcupacionAnfitrion(const string& documentoAnfitrion, int anio) const {
+    int indiceAnfitrion = indiceAnfitriones.buscar(documentoAnfitrion);
+    if (indiceAnfitrion < 0) return nullptr;
+
+    int cantidad = 0;
+    const int* suyos = getAlojamientosDeAnfitrion(indiceAnfitrion, cantidad);
+
+    AnaliticaOcupacion* analitica = new AnaliticaOcupacion(cantidad, anio);
+    agregarMemoria(sizeof(AnaliticaOcupacion));
+    cargarAnaliticaOcupacion(*analitica, suyos, cantidad);
+    analitica->calcular();
+    return analitica;
+}
+
+/**
+ * @brief Genera el reporte de ocupación e ingresos de todos los anfitriones (comando por lotes).
+ *
+ * Escribe una línea por anfitrión, alojamiento y mes:
+ * "documentoAnfitrion|codigoAlojamiento|AAAA-MM|noches|ocupacion%|ingresos".
+ *
+ * @param anio Año del reporte.
+ * @param nombreArchivo Archivo de salida.
+ * @return true si el archivo se escribió.
+ *
+ * @throws std::invalid_argument si el año no es válido.
+ */
+bool Sistema::generarReporteOcupacion(int anio, const string& nombreArchivo) const {
+    int* todos = new int[numAlojamientos > 0 ? numAlojamientos : 1];
+    agregarMemoria(sizeof(int) * numAlojamientos);
+    for (int i = 0; i < numAlojamientos; ++i) {
+        incrementarIteracion();
+        todos[i] = i;
+    }
+
+    AnaliticaOcupacion analitica(numAlojamientos, anio);
+    cargarAnaliticaOcupacion(analitica, todos, numAlojamientos);
+    analitica.calcular();
+
+    delete[] todos;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * numAlojamientos));
+
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        cout << "Error: No se pudo crear el archivo " << nombreArchivo << "\n";
+        return false;
+    }
+
+    archivo << fixed;
+    for (int h = 0; h < numAnfitriones; ++h) {
+        incrementarIteracion();
+        int cantidad = 0;
+        const int* suyos = getAlojamientosDeAnfitrion(h, cantidad);
+        for (int i = 0; i < cantidad; ++i) {
+            for (int mes = 0; mes < 12; ++mes) {
+                incrementarIteracion();
+                archivo << anfitriones[h].getDocumento() << "|" << alojamientos[suyos[i]].getCodigo() << "|"
+                        << anio << "-" << setw(2) << setfill('0') << mes + 1 << setfill(' ') << "|"
+                        << analitica.getNochesVendidas(suyos[i], mes) << "|"
+                        << setprecision(1) << analitica.getOcupacion(suyos[i], mes) * 100 << "|"
+                        << analitica.getIngresos(suyos[i], mes) << "\n";
+            }
+        }
+    }
+    return archivo.good();
+}
+
+/**
+ * @brief Calendario de ocupación de un mes para los alojamientos de un anfitrión.
+ *
+ * Cada alojamiento se resuelve con su agenda (`AgendaAlojamientos::calcularMapaOcupacion`),
+ * así que el costo depende de los alojamientos del anfitrión y de sus reservaciones en el
+ * mes, no del total de reservaciones de la plataforma.
+ *
+ * Las estadías ya movidas al histórico solo ocupan noches anteriores a la última fecha de
+ * corte; si el mes empieza antes, se agregan las del histórico con entrada desde
+ * `DIAS_ATRAS_CALENDARIO_HISTORICO` días antes del mes, leyendo solo sus columnas numéricas
+ * (`ArchivoHistorico::leerFilas`).
+ *
+ * @param documentoAnfitrion Documento del anfitrión.
+ * @param mes Mes del calendario (1 a 12).
+ * @param anio Año del calendario.
+ * @param cantidad [out] Cantidad de alojamientos del anfitrión (posiciones del arreglo).
+ * @return unsigned int* Mapa de noches ocupadas de cada alojamiento, en el orden de
+ *         `getAlojamientosDeAnfitrion`: el bit d corresponde al día d + 1 del mes. nullptr si
+ *         el anfitrión no existe o no tiene alojamientos.
+ *
+ * @throws std::invalid_argument si el mes o el año no son válidos.
+ * @note El arreglo retornado se reserva con new[]: el llamador debe liberarlo con delete[].
+ */
+unsigned int* Sistema::obtenerCalendarioAnfitrion(const string& documentoAnfitrion, int mes, int anio,
+                                                  int& cantidad) const {
+    cantidad = 0;
+    Fecha primerDia(1, mes, anio);
+    if (!primerDia.esValida()) {
+        throw invalid_argument("Mes o anio fuera del rango valido.");
+    }
+    int indiceAnfitrion = buscarIndiceAnfitrion(documentoAnfitrion);
+    if (indiceAnfitrion < 0) {
+        return nullptr;
+    }
+    const int* suyos = getAlojamientosDeAnfitrion(indiceAnfitrion, cantidad);
+    if (cantidad == 0) {
+        return nullptr;
+    }
+
+    int desde = primerDia.aDiasDesdeFechaBase();
+    int dias = Fecha(1, mes % 12 + 1, anio + mes / 12).aDiasDesdeFechaBase() - desde;
+    unsigned int* mapas = new unsigned int[cantidad];
+    agregarMemoria(sizeof(unsigned int) * cantidad);
+    for (int i = 0; i < cantidad; ++i) {
+        incrementarIteracion();
+        mapas[i] = agenda->calcularMapaOcupacion(suyos[i], desde, dias);
+    }
+
+    // Estadias del historico, si el mes empieza antes de la ultima fecha de corte
+    Fecha ultimoCorte(gestionArchivos->cargarUltimaFechaCorteHistorico());
+    if (!ultimoCorte.esValida() || desde < ultimoCorte.aDiasDesdeFechaBase()) {
+        IndiceHash posicionCalendario;
+        posicionCalendario.reservar(cantidad);
+        for (int i = 0; i < cantidad; ++i) {
+            incrementarIteracion();
+            posicionCalendario.insertar(alojamientos[suyos[i]].getCodigo(), i);
+        }
+
+        int numHistoricas = 0;
+        FilaHistorica* historicas = gestionArchivos->getHistorico().leerFilas(
+            desde - DIAS_ATRAS_CALENDARIO_HISTORICO, desde + dias - 1, posicionCalendario, true, numHistoricas);
+        for (int k = 0; k < numHistoricas; ++k) {
+            incrementarIteracion();
+            int inicio = max(historicas[k].diaEntrada, desde) - desde;
+            int fin = min(historicas[k].diaEntrada + historicas[k].noches, desde + dias) - desde;
+            if (inicio < fin) {
+                unsigned int tramo = (fin - inicio == 32) ? ~0u : ((1u << (fin - inicio)) - 1);
+                mapas[historicas[k].alojamiento] |= tramo << inicio;
+            }
+        }
+        delete[] historicas;
+        agregarMemoria(-static_cast<long long>(sizeof(FilaHistorica) * numHistoricas));
+    }
+    return mapas;
+}
+
+/**
+ * @brief Suma o resta el pago de una reservación en el resumen de pagos.
+ *
+ * Las reservaciones con fecha de pago inválida no se resumen.
+ *
+ * @param reservacion Reservación agregada o cancelada.
+ * @param signo 1 para una reservación nueva, -1 para una cancelada.
+ */
+void Sistema::registrarPagoEnResumen(const Reservacion& reservacion, int signo) {
+    Fecha fechaPago(reservacion.getFechaPago());
+    if (!fechaPago.esValida()) return;
+
+    int indiceAlojamiento = indiceAlojamientos.buscar(reservacion.getCodigoAlojamiento());
+    int departamento = resumenPagos->registrarDepartamento(
+        indiceAlojamiento >= 0 ? alojamientos[indiceAlojamiento].getDepartamento() : "Sin departamento");
+    resumenPagos->registrar(departamento, fechaPago.aDiasDesdeFechaBase(), reservacion.getMetodoPago(),
+                            llround(reservacion.getMonto()), signo);
+}
+
+/**
+ * @brief Reconstruye el resumen de pagos con las reservaciones activas y las del histórico.
+ *
+ * Las reservaciones se convierten en columnas enteras (día de pago, departamento, método y
+ * monto) y el resumen las acumula en paralelo (ver `ResumenPagos::reconstruir`). Del
+ * histórico solo se leen sus columnas numéricas (`ArchivoHistorico::leerFilas`), con el
+ * alojamiento ya traducido a su índice. Se invoca al construir los índices; después el
+ * resumen se mantiene con cada reservación nueva o cancelada. El corte histórico no lo
+ * cambia: solo mueve reservaciones de lugar.
+ */
+void Sistema::reconstruirResumenPagos() {
+    int numHistoricas = 0;
+    FilaHistorica* historicas = gestionArchivos->getHistorico().leerFilas(INT_MIN, INT_MAX, indiceAlojamientos,
+                                                                          false, numHistoricas);
+    int filas = numReservaciones + numHistoricas;
+
+    int* diasPago = new int[filas > 0 ? filas : 1];
+    int* departamentos = new int[filas > 0 ? filas : 1];
+    int* metodos = new int[filas > 0 ? filas : 1];
+    long long* montos = new long long[filas > 0 ? filas : 1];
+    agregarMemoria((sizeof(int) * 3 + sizeof(long long)) * filas);
+
+    // Los departamentos se registran aqui, antes de repartir las filas entre los hilos
+    resumenPagos->limpiar();
+    int sinDepartamento = -1;
+    int numFilas = 0;
+    for (int i = 0; i < filas; ++i) {
         incrementarIteracion();
-        Fecha inicio(reservaciones[i].getFechaEntrada());
-        Fecha fin = inicio.calcularFechaFinal(reservaciones[i].getDuracion());
-        if (fin < fechaHoy) {
-            reservacionesParaHistorico[iH++] = reservaciones[i];
+        int diaPago, indiceAlojamiento;
+        char metodoPago;
+        long long monto;
+        if (i < numReservaciones) {
+            Fecha fechaPago(reservaciones[i].getFechaPago());
+            diaPago = fechaPago.esValida() ? fechaPago.aDiasDesdeFechaBase() : FilaHistorica::SIN_FECHA_PAGO;
+            indiceAlojamiento = indiceAlojamientos.buscar(reservaciones[i].getCodigoAlojamiento());
+            metodoPago = reservaciones[i].getMetodoPago();
+            monto = llround(reservaciones[i].getMonto());
         } else {
-            reservacionesParaMantener[iM++] = reservaciones[i];
+            const FilaHistorica& historica = historicas[i - numReservaciones];
+            diaPago = historica.diaPago;
+            indiceAlojamiento = historica.alojamiento;
+            metodoPago = historica.metodoPago;
+            monto = historica.monto;
         }
+        if (diaPago == FilaHistorica::SIN_FECHA_PAGO) continue;
+
+        int departamento;
+        if (indiceAlojamiento >= 0) {
+            departamento = resumenPagos->registrarDepartamento(alojamientos[indiceAlojamiento].getDepartamento());
+        } else {
+            if (sinDepartamento < 0) sinDepartamento = resumenPagos->registrarDepartamento("Sin departamento");
+            departamento = sinDepartamento;
+        }
+
+        diasPago[numFilas] = diaPago;
+        departamentos[numFilas] = departamento;
+        metodos[numFilas] = ResumenPagos::indiceMetodo(metodoPago);
+        montos[numFilas] = monto;
+        numFilas++;
     }
 
-    if (gestionArchivos->guardarReservacionesHistorico(reservacionesParaHistorico, reservacionesFinalizadas, fechaCorte.toString())) {
+    delete[] historicas;
+    agregarMemoria(-static_cast<long long>(sizeof(FilaHistorica) * numHistoricas));
 
-        agregarMemoria(-sizeof(Reservacion) * numReservaciones);
-        delete[] reservaciones;
+    resumenPagos->reconstruir(diasPago, departamentos, metodos, montos, numFilas);
 
-        reservaciones = reservacionesParaMantener;
-        numReservaciones = reservacionesActivas;
+    delete[] diasPago;
+    delete[] departamentos;
+    delete[] metodos;
+    delete[] montos;
+    agregarMemoria(-static_cast<long long>((sizeof(int) * 3 + sizeof(long long)) * filas));
+}
 
-        gestionArchivos->actualizarArchivoReservaciones(reservaciones, numReservaciones);
-        gestionArchivos->guardarUltimaFechaCorteHistorico(fechaCorte.toString());
-        cout << "Actualizacion completada. Activas: " << reservacionesActivas << endl;
-        mostrarEstadisticasHistorico(fechaCorte, reservacionesFinalizadas, reservacionesActivas, reservacionesEnCurso);
-    } else {
-        cout << "Error al guardar en historico.\n";
+/**
+ * @brief Resumen de pagos del sistema (se construye al cargar los datos).
+ *
+ * @return Referencia al resumen de pagos del sistema.
+ */
+const ResumenPagos& Sistema::obtenerResumenPagos() const {
+    return *resumenPagos;
+}
+
+/**
+ * @brief Muestra los pagos de un rango de fechas por departamento y método de pago.
+ *
+ * Cada cifra sale del resumen de pagos, recorriendo solo los días del rango.
+ *
+ * @param desde Primera fecha de pago.
+ * @param hasta Última fecha de pago (inclusive).
+ */
+void Sistema::mostrarResumenPagos(const Fecha& desde, const Fecha& hasta) const {
+    const ResumenPagos& resumen = obtenerResumenPagos();
+    int diaDesde = desde.aDiasDesdeFechaBase();
+    int diaHasta = hasta.aDiasDesdeFechaBase();
+    const char* nombresMetodos[ResumenPagos::NUM_METODOS_PAGO] = {"TC", "PSE", "Otro"};
+
+    cout << "\n=== RESUMEN DE PAGOS " << desde.toString() << " - " << hasta.toString() << " ===\n";
+    cout << left << setw(24) << "Departamento";
+    for (int m = 0; m < ResumenPagos::NUM_METODOS_PAGO; ++m) {
+        cout << right << setw(16) << nombresMetodos[m];
+    }
+    cout << right << setw(16) << "Total" << setw(10) << "Pagos" << "\n";
+
+    cout << fixed << setprecision(0);
+    for (int fila = 0; fila <= resumen.getNumDepartamentos(); ++fila) {
+        // La ultima fila suma todos los departamentos (-1)
+        int departamento = (fila < resumen.getNumDepartamentos()) ? fila : -1;
+        incrementarIteracion();
+
+        cout << left << setw(24) << (departamento >= 0 ? resumen.getDepartamento(departamento) : "TOTAL");
+        int cantidad = 0;
+        for (int m = 0; m < ResumenPagos::NUM_METODOS_PAGO; ++m) {
+            cout << right << setw(16) << resumen.consultar(diaDesde, diaHasta, departamento, m, cantidad);
+        }
+        long long total = resumen.consultar(diaDesde, diaHasta, departamento, -1, cantidad);
+        cout << right << setw(16) << total << setw(10) << cantidad << "\n";
+    }
+}
+
+/**
+ * @brief Reconstruye los contadores de disponibilidad por municipio desde la agenda.
+ *
+ * La ventana empieza hoy y cubre `DIAS_HORIZONTE_DISPONIBILIDAD` noches. Se invoca al
+ * construir los índices, después de cada corte histórico y cuando cambia el día.
+ */
+void Sistema::construirDisponibilidad() {
+    int hoy = Fecha(Fecha::obtenerFechaActual()).aDiasDesdeFechaBase();
+    disponibilidad->construir(*agenda, *catalogo, hoy, DIAS_HORIZONTE_DISPONIBILIDAD);
+}
 
-        agregarMemoria(-sizeof(Reservacion) * reservacionesActivas);
-        delete[] reservacionesParaMantener;
+/**
+ * @brief Actualiza los contadores de disponibilidad con las noches de una reservación.
+ *
+ * Una noche solo cambia el contador si cambia el estado del alojamiento: al reservar
+ * (signo 1) debe llamarse antes de registrar la reservación en la agenda y cuenta las
+ * noches que estaban libres; al cancelar (signo -1) debe llamarse después de retirarla y
+ * cuenta las noches que quedaron libres. Así las reservaciones superpuestas no se cuentan
+ * dos veces.
+ *
+ * @param indiceAlojamiento Índice del alojamiento (-1 si no existe: no se hace nada).
+ * @param diaEntrada Día de entrada, contado desde la fecha base.
+ * @param noches Duración de la estadía.
+ * @param signo 1 para una reservación nueva, -1 para una cancelada.
+ */
+void Sistema::registrarNochesEnDisponibilidad(int indiceAlojamiento, int diaEntrada, int noches, int signo) {
+    if (indiceAlojamiento < 0) {
+        return;
+    }
+    int municipio = catalogo->getIdMunicipio(catalogo->getFilaDeAlojamiento(indiceAlojamiento));
+    int primerDia = max(diaEntrada, disponibilidad->getDiaBase());
+    int ultimoDia = min(diaEntrada + noches, disponibilidad->getDiaBase() + disponibilidad->getNumDias());
+    for (int dia = primerDia; dia < ultimoDia; ++dia) {
+        if (agenda->estaLibre(indiceAlojamiento, dia, 1)) {
+            disponibilidad->registrar(municipio, dia, signo);
+        }
+    }
+}
+
+/**
+ * @brief Cantidad de alojamientos libres de un municipio en cada noche de un rango.
+ *
+ * Las noches dentro del horizonte se leen directamente de los contadores por municipio
+ * (O(1) por noche); las que quedan fuera se cuentan en la agenda de cada alojamiento del
+ * municipio. Si el día cambió desde la última construcción, los contadores se rehacen
+ * antes de leerlos.
+ *
+ * @param municipio Nombre del municipio (sin distinguir mayúsculas ni tildes, como en la búsqueda).
+ * @param desde Primera noche.
+ * @param noches Cantidad de noches del rango.
+ * @return int* Arreglo de `noches` posiciones con los alojamientos libres de cada noche, o
+ *         nullptr si el municipio no tiene alojamientos.
+ *
+ * @throws std::invalid_argument si la fecha no es válida o la cantidad de noches no es positiva.
+ * @note El arreglo retornado se reserva con new[]: el llamador debe liberarlo con delete[].
+ */
+int* Sistema::obtenerDisponibilidadMunicipio(const string& municipio, const Fecha& desde, int noches) {
+    if (!desde.esValida() || noches <= 0) {
+        throw invalid_argument("Rango de noches invalido.");
+    }
+    int idMunicipio = catalogo->buscarIdMunicipio(municipio);
+    if (idMunicipio < 0) {
+        return nullptr;
+    }
+    if (disponibilidad->getDiaBase() != Fecha(Fecha::obtenerFechaActual()).aDiasDesdeFechaBase()) {
+        construirDisponibilidad();
+    }
+
+    int* libres = new int[noches];
+    agregarMemoria(sizeof(int) * noches);
+
+    int primerDia = desde.aDiasDesdeFechaBase();
+    for (int d = 0; d < noches; ++d) {
+        incrementarIteracion();
+        int dia = primerDia + d;
+        if (disponibilidad->cubre(dia)) {
+            libres[d] = disponibilidad->getLibres(idMunicipio, dia);
+            continue;
+        }
+        libres[d] = 0;
+        for (int fila = catalogo->getInicioMunicipio(idMunicipio); fila < catalogo->getFinMunicipio(idMunicipio); ++fila) {
+            if (agenda->estaLibre(catalogo->getAlojamientoDeFila(fila), dia, 1)) {
+                libres[d]++;
+            }
+        }
+    }
+    return libres;
+}
+
+/**
+ * @brief Muestra los alojamientos libres de un municipio noche a noche.
+ *
+ * @param municipio Nombre del municipio.
+ * @param desde Primera noche.
+ * @param noches Cantidad de noches a mostrar.
+ */
+void Sistema::mostrarDisponibilidadMunicipio(const string& municipio, const Fecha& desde, int noches) {
+    int* libres = obtenerDisponibilidadMunicipio(municipio, desde, noches);
+    if (!libres) {
+        cout << "No hay alojamientos en el municipio " << municipio << ".\n";
+        return;
+    }
+    int idMunicipio = catalogo->buscarIdMunicipio(municipio);
+    int total = catalogo->getFinMunicipio(idMunicipio) - catalogo->getInicioMunicipio(idMunicipio);
+
+    cout << "\n=== DISPONIBILIDAD EN " << catalogo->getNombreMunicipio(idMunicipio)
+         << " (" << total << " alojamientos) ===\n";
+    cout << left << setw(14) << "Noche" << right << setw(10) << "Libres" << setw(12) << "Ocupacion" << "\n";
+
+    int primerDia = desde.aDiasDesdeFechaBase();
+    cout << fixed << setprecision(1);
+    for (int d = 0; d < noches; ++d) {
+        incrementarIteracion();
+        cout << left << setw(14) << Fecha::desdeDiasFechaBase(primerDia + d).toString()
+             << right << setw(10) << libres[d]
+             << setw(11) << (total > 0 ? 100.0 * (total - libres[d]) / total : 0.0) << "%\n";
     }
 
-    agregarMemoria(-sizeof(Reservacion) * reservacionesFinalizadas);
-    delete[] reservacionesParaHistorico;
+    delete[] libres;
+    agregarMemoria(-static_cast<long long>(sizeof(int) * noches));
 }
@@ -2,6 +2,9 @@
 #define SISTEMA_H
 
 #include "fecha.h"
+#include "indicehash.h"
+#include "solicitudreservacion.h"
+
 #include <string>
 
 class Anfitrion;
@@ -9,6 +12,13 @@ class Huesped;
 class Alojamiento;
 class Reservacion;
 class GestionArchivos;
+class CatalogoAlojamientos;
+class AgendaAlojamientos;
+class CacheBusquedas;
+class AnaliticaOcupacion;
+class ResumenPagos;
+class DisponibilidadMunicipios;
+struct FacetasBusqueda;
 
 using namespace std;
 
@@ -22,6 +32,26 @@ private:
     Alojamiento* alojamientos;
     Reservacion* reservaciones;
     GestionArchivos* gestionArchivos;
+    CatalogoAlojamientos* catalogo;
+    AgendaAlojamientos* agenda;
+    CacheBusquedas* cacheBusquedas;
+
+    // Totales diarios de pagos; se construye al cargar los datos y luego se mantiene
+    ResumenPagos* resumenPagos;
+
+    // Alojamientos ocupados por municipio y noche, desde hoy; se mantiene con cada reservacion
+    DisponibilidadMunicipios* disponibilidad;
+
+    // Buffer de trabajo de la sesion para los resultados de busqueda (indices de alojamientos)
+    int* bufferBusqueda;
+
+    // Indices construidos al cargar los datos
+    IndiceHash indiceAnfitriones;           // documento -> indice del anfitrion
+    IndiceHash indiceUsuarios;              // documento -> usuario (anfitriones primero, luego huespedes)
+    IndiceHash indiceHuespedes;             // documento -> indice del huesped
+    IndiceHash indiceAlojamientos;          // codigo -> indice del alojamiento
+    int* inicioAlojamientosAnfitrion;       // rango de cada anfitrion dentro de alojamientosPorAnfitrion
+    int* alojamientosPorAnfitrion;          // indices de alojamientos agrupados por anfitrion
 
     int numAnfitriones;
     int numHuespedes;
@@ -29,12 +59,26 @@ private:
     int numReservaciones;
 
     int ultimoIdReservacion;
-    bool esReservacionDelAnfitrionEnRango(const Reservacion& reserva,
-                                          const string& documentoAnfitrion,
-                                          const Fecha& fechaInicio,
-                                          const Fecha& fechaFin,
-                                          const Alojamiento* alojamientos,
-                                          int totalAlojamientos) const;
+
+    // Las reservaciones se mantienen ordenadas por dia de salida: las finalizadas son un prefijo
+    int duracionMaximaReservacion;
+    int diaSalidaReservacion(int indice) const;
+    int contarReservacionesQueSalenHasta(int dia) const;
+    void ordenarReservacionesPorSalida();
+    bool moverFinalizadasAlHistorico(int finalizadas, const Fecha& fechaCorte);
+
+    // Dia (desde la fecha base) en que ya se ejecuto el corte historico automatico
+    int diaUltimoCorteAutomatico;
+
+    void construirIndices();
+    static string formatearCodigoReservacion(int id);
+    void registrarPagoEnResumen(const Reservacion& reservacion, int signo);
+    void construirDisponibilidad();
+    void registrarNochesEnDisponibilidad(int indiceAlojamiento, int diaEntrada, int noches, int signo);
+    void cargarAnaliticaOcupacion(AnaliticaOcupacion& analitica, const int* alojamientosReporte,
+                                  int numAlojamientosReporte) const;
+    int filtrarCandidatos(const string& municipio, float precioMax, float puntuacionMin,
+                          const string& amenidadesRequeridas);
 
     friend class GestionArchivos;
 
@@ -65,6 +109,12 @@ public:
                                       int& totalFuturas,
                                       int& totalPasadas) const;
 
+    // Historial completo del huesped: activas (futuras y pasadas) seguidas de las del historico
+    Reservacion* obtenerHistorialHuesped(const string& documentoHuesped,
+                                         int& totalFuturas,
+                                         int& totalPasadas,
+                                         int& totalHistoricas) const;
+
     // Sobrecarga para anfitrion
     Reservacion* obtenerReservaciones(const string& documentoAnfitrion,
                                       const Fecha& fechaInicio,
@@ -74,28 +124,76 @@ public:
     // Metodos
     void cargarDatos();
     //bool guardarDatos();
-    bool autenticarUsuario(const string& doc, const string& clave, string& tipoRol);
+    bool autenticarUsuario(const string& doc, const string& clave, string& tipoRol, int& indiceUsuario);
     bool iniciarSesion(const string& documento, const string& clave);
     void mostrarMenuHuesped(Huesped& huesped);
     void mostrarMenuAnfitrion(Anfitrion& anfitrion);
 
-    Alojamiento* filtrarAlojamientosDisponibles(const string& municipio, float precioMax,
-    float puntuacionMin, int& cantidadFiltrada);
+    int filtrarAlojamientosDisponibles(const string& municipio, float precioMax,
+    float puntuacionMin, const int* idsAmenidades, int numIdsAmenidades, int* seleccion);
 
-    // Metodo unificado para buscar alojamientos disponibles
-    Alojamiento* buscarAlojamientosDisponibles(const string& municipio,
+    // Metodo unificado para buscar alojamientos disponibles (retorna indices en getAlojamientos())
+    const int* buscarAlojamientosDisponibles(const string& municipio,
                                                const Fecha& fechaEntrada,
                                                int noches,
                                                float precioMax,
                                                float puntuacionMin,
-                                               int& cantidadEncontrada);
+                                               const string& amenidadesRequeridas,
+                                               int& cantidadEncontrada,
+                                               FacetasBusqueda* facetas = nullptr);
+
+    // Busqueda ordenada y paginada: criterio 'P' (precio), 'R' (puntuacion del anfitrion) o 'T' (costo total)
+    const int* buscarAlojamientosOrdenados(const string& municipio,
+                                           const Fecha& fechaEntrada,
+                                           int noches,
+                                           float precioMax,
+                                           float puntuacionMin,
+                                           const string& amenidadesRequeridas,
+                                           char criterioOrden,
+                                           int limite,
+                                           int desplazamiento,
+                                           int& cantidadPagina,
+                                           int& totalEncontrados,
+                                           FacetasBusqueda* facetas = nullptr);
+
+    // Busqueda con fechas flexibles: alojamientos con alguna fecha de entrada posible entre desde y hasta
+    const int* buscarAlojamientosFlexibles(const string& municipio,
+                                           const Fecha& desde,
+                                           const Fecha& hasta,
+                                           int noches,
+                                           float precioMax,
+                                           float puntuacionMin,
+                                           const string& amenidadesRequeridas,
+                                           int& cantidadEncontrada);
+    Fecha* obtenerFechasInicioPosibles(int indiceAlojamiento, const Fecha& desde, const Fecha& hasta,
+                                       int noches, int& numRangos) const;
+
+    // Alojamientos que cumplen los filtros pero estan ocupados, y su proxima fecha de entrada libre
+    const int* buscarAlojamientosOcupados(const string& municipio,
+                                          const Fecha& fechaEntrada,
+                                          int noches,
+                                          float precioMax,
+                                          float puntuacionMin,
+                                          const string& amenidadesRequeridas,
+                                          int& cantidadEncontrada);
+    Fecha obtenerProximaFechaDisponible(int indiceAlojamiento, const Fecha& desde, int noches) const;
+    Fecha* obtenerProximasFechasDisponibles(const int* indicesAlojamientos, int cantidad,
+                                            const Fecha& desde, int noches) const;
 
     // Crear reservacion completa
     Reservacion* crearReservacion(const Alojamiento& alojamiento,const Fecha& fechaEntrada,
     int noches, Huesped* huesped);
 
+    // Consultas sobre los indices de anfitriones
+    int buscarIndiceAnfitrion(const string& documentoAnfitrion) const;
+    const int* getAlojamientosDeAnfitrion(int indiceAnfitrion, int& cantidad) const;
+
+    // Consulta sobre el indice de huespedes
+    int buscarIndiceHuesped(const string& documentoHuesped) const;
+
     // Metodo para buscar alojamiento por codigo especifico
     Alojamiento* buscarAlojamientoPorCodigo(const string& codigo);
+    int buscarIndiceAlojamiento(const string& codigo) const;
 
     // Validar que huesped no tenga conflictos de reserva
     bool validarDisponibilidadHuesped(const string& documentoHuesped, const Fecha& fechaEntrada,
@@ -109,10 +207,31 @@ public:
     // Agregar reservacion al sistema y guardar en archivo
     void agregarReservacion(const Reservacion& reservacion);
 
+    // Reservaciones por lotes: resuelve los conflictos del lote y guarda las ganadoras de una vez
+    int reservarEnLote(SolicitudReservacion* solicitudes, int cantidad);
+
     // Metodos para el corte historico
     string obtenerUltimaFechaCorteHistorico();
     void procesarActualizacionHistorico(const Fecha& fechaCorte);
+    int ejecutarCorteHistoricoAutomatico();
     void mostrarEstadisticasHistorico(const Fecha& fechaCorte, int finalizadas, int activas, int enCurso);
+
+    // Ocupacion e ingresos por alojamiento y mes, con reservaciones activas e historicas
+    AnaliticaOcupacion* calcularOcupacionAnfitrion(const string& documentoAnfitrion, int anio) const;
+    bool generarReporteOcupacion(int anio, const string& nombreArchivo) const;
+
+    // Calendario de un mes: mapa de noches ocupadas (bit d = dia d + 1) por alojamiento del anfitrion
+    unsigned int* obtenerCalendarioAnfitrion(const string& documentoAnfitrion, int mes, int anio,
+                                             int& cantidad) const;
+
+    // Totales de pagos por dia, departamento y metodo de pago
+    const ResumenPagos& obtenerResumenPagos() const;
+    void reconstruirResumenPagos();
+    void mostrarResumenPagos(const Fecha& desde, const Fecha& hasta) const;
+
+    // Alojamientos libres de un municipio noche a noche (lecturas directas dentro del horizonte)
+    int* obtenerDisponibilidadMunicipio(const string& municipio, const Fecha& desde, int noches);
+    void mostrarDisponibilidadMunicipio(const string& municipio, const Fecha& desde, int noches);
 };
 
 #endif // SISTEMA_H
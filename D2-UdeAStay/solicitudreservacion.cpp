@@ -0,0 +1,20 @@
+#include "solicitudreservacion.h"
+
+/**
+ * @brief Texto de un resultado de `Sistema::reservarEnLote`.
+ *
+ * @param resultado Código de resultado (constantes de `SolicitudReservacion`).
+ * @return Descripción corta del resultado.
+ */
+string SolicitudReservacion::describirResultado(int resultado) {
+    switch (resultado) {
+    case RESERVADA:               return "Reservada";
+    case DATOS_INVALIDOS:         return "Datos invalidos";
+    case ALOJAMIENTO_INEXISTENTE: return "Alojamiento inexistente";
+    case HUESPED_INEXISTENTE:     return "Huesped inexistente";
+    case ALOJAMIENTO_OCUPADO:     return "Alojamiento ocupado en esas fechas";
+    case CONFLICTO_EN_LOTE:       return "Conflicto con otra solicitud del lote";
+    case HUESPED_OCUPADO:         return "El huesped ya tiene una estadia en esas fechas";
+    default:                      return "Desconocido";
+    }
+}
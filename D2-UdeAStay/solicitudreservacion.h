@@ -0,0 +1,35 @@
+#ifndef SOLICITUDRESERVACION_H
+#define SOLICITUDRESERVACION_H
+
+#include "fecha.h"
+
+#include <string>
+
+using namespace std;
+
+// Solicitud de una reservacion por lotes (sin interaccion) y su resultado
+struct SolicitudReservacion {
+    // Resultados posibles
+    static const int RESERVADA = 0;
+    static const int DATOS_INVALIDOS = 1;           // Fecha pasada o invalida, noches o metodo de pago invalidos
+    static const int ALOJAMIENTO_INEXISTENTE = 2;
+    static const int HUESPED_INEXISTENTE = 3;
+    static const int ALOJAMIENTO_OCUPADO = 4;       // Se cruza con una reservacion ya registrada
+    static const int CONFLICTO_EN_LOTE = 5;         // Otra solicitud del lote gano esas noches del alojamiento
+    static const int HUESPED_OCUPADO = 6;           // El huesped ya tiene una estadia (registrada o del lote) en esas fechas
+
+    string codigoAlojamiento;
+    string documentoHuesped;
+    Fecha fechaEntrada;
+    int noches;
+    char metodoPago;                                // 'T' (tarjeta de credito) o 'P' (PSE)
+    string anotaciones;
+
+    // Salida
+    int resultado;
+    string codigoReservacion;                       // Solo si quedo reservada
+
+    static string describirResultado(int resultado);
+};
+
+#endif // SOLICITUDRESERVACION_H